@@ -1,16 +1,22 @@
 #pragma once
 #include "basic_vector.hpp"
 namespace force::math {
+    // Blocked GEMM of the batch kernels, see primary_batch.hpp.
+    // c = a * b with a m x k and b k x n, all stored row after row, lda, ldb
+    // and ldc elements from one row to the next.
+    void Mat_gemm(const float32_t* a, std::size_t lda, const float32_t* b, std::size_t ldb,
+                  float32_t* c, std::size_t ldc, std::size_t m, std::size_t k, std::size_t n);
+    // y = a * x, a m x n without gaps.
+    void Mat_gemv(const float32_t* a, const float32_t* x, float32_t* y, std::size_t m, std::size_t n);
+    // Float products with at least this many multiply-adds go through Mat_gemm,
+    // below it packing costs more than the loop loses to cache misses.
+    inline constexpr std::size_t Mat_gemm_threshold = 32 * 32 * 32;
 
     template <typename Ty,
               std::size_t Col, std::size_t Row, 
               class VecPipeT>
     class basic_matrix {
         // Vector class stores actual Data.
-#define SBEG_PTR    (&(vdata[0][0]))
-#define SEND_PTR    (&(vdata[0][0]) + Col * Row)
-#define RBEG_PTR    (&(right.vdata[0][0]))
-#define REND_PTR    (&(right.vdata[0][0]) + Col * Row)
     public:
         union {
             // Vector form of data.
@@ -25,75 +31,69 @@ namespace force::math {
         static constexpr std::size_t col = Col;
         static constexpr std::size_t row = Row;
         // Value constructor.
-        // All lst elements should be Ty values. Initalizer_list has no size bound.
-        // So make sure your size is always in the acceptable range.
-        constexpr basic_matrix(std::initializer_list<Ty> lst) {
-            std::fill(SBEG_PTR, SEND_PTR, static_cast<value_type>(0));
-            std::copy(lst.begin(), lst.end(), SBEG_PTR);
+        // All lst elements should be Ty values, row after row. Missing elements
+        // are zero and extra ones are ignored.
+        // Constructors start vdata (not adata), so matrices work in constant
+        // expressions too, walked row by row instead of as one flat array.
+        constexpr basic_matrix(std::initializer_list<Ty> lst) : vdata{} {
+            auto it = lst.begin();
+            for (std::size_t i = 0; i < col && it != lst.end(); ++i)
+                for (std::size_t j = 0; j < row && it != lst.end(); ++j) vdata[i][j] = *it++;
         }
         // ArgPipes are all basic_vector<Ty, Row, VecPipeT>
         // Make sure all parameters are this type. I don't know
         // what will happen if you pass in other types.
         // And make sure your parameter count is less or equal than Mat's column size.
         template <typename ... ArgVecs>
-        constexpr basic_matrix(const ArgVecs& ... avs) {
+        constexpr basic_matrix(const ArgVecs& ... avs) : vdata{} {
             // List that stores all Vectors.
             std::initializer_list<basic_vector<Ty, Row, VecPipeT>> init_lst = { (basic_vector<Ty, Row, VecPipeT>)avs... };
-            std::fill(SBEG_PTR, SEND_PTR, static_cast<value_type>(0));
             std::copy(init_lst.begin(), init_lst.end(), vdata);
         }
-        basic_matrix(const basic_matrix& right) {
-            std::fill(SBEG_PTR, SEND_PTR, static_cast<value_type>(0));
-            std::copy(RBEG_PTR, REND_PTR, SBEG_PTR);
-        }
-        basic_matrix(basic_matrix&& right) {
-            std::fill(SBEG_PTR, SEND_PTR, static_cast<value_type>(0));
-            std::move(RBEG_PTR, REND_PTR, SBEG_PTR);
-        }
-
-        basic_matrix& operator=(const basic_matrix& right) {
-            std::copy(RBEG_PTR, REND_PTR, SBEG_PTR);
-            return *this;
-        }
-        basic_matrix& operator=(basic_matrix&& right) {
-            std::move(RBEG_PTR, REND_PTR, SBEG_PTR);
-            return *this;
-        }
-        basic_matrix& operator+=(const basic_matrix& right) {
+        // Trivial copies, so arrays of matrices are copied and resized with memcpy.
+        constexpr basic_matrix(const basic_matrix& right)            = default;
+        constexpr basic_matrix(basic_matrix&& right)                 = default;
+        constexpr basic_matrix& operator=(const basic_matrix& right) = default;
+        constexpr basic_matrix& operator=(basic_matrix&& right)      = default;
+        // Lazy expressions (see expression.hpp) are evaluated here in one loop.
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_matrix>
+        basic_matrix(const E& e)                { Expr_assign<Expr_set>(adata, e); }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_matrix>
+        basic_matrix& operator=(const E& e)     { Expr_assign<Expr_set>(adata, e); return *this; }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_matrix>
+        basic_matrix& operator+=(const E& e)    { Expr_assign<Expr_add>(adata, e); return *this; }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_matrix>
+        basic_matrix& operator-=(const E& e)    { Expr_assign<Expr_sub>(adata, e); return *this; }
+        constexpr basic_matrix& operator+=(const basic_matrix& right) {
             #pragma omp simd
             for (std::size_t i = 0; i < col; ++i) vdata[i] += right.vdata[i];
             return *this;
         }
-        basic_matrix& operator-=(const basic_matrix& right) {
+        constexpr basic_matrix& operator-=(const basic_matrix& right) {
             #pragma omp simd
             for (std::size_t i = 0; i < col; ++i) vdata[i] -= right.vdata[i];
             return *this;
         }
-        basic_matrix& operator*=(const value_type& k) {
+        constexpr basic_matrix& operator*=(const value_type& k) {
             #pragma omp simd
             for (std::size_t i = 0; i < col; ++i) vdata[i] *= k;
             return *this;
         }
-        basic_matrix& operator/=(const value_type& k) {
+        constexpr basic_matrix& operator/=(const value_type& k) {
             #pragma omp simd
             for (std::size_t i = 0; i < col; ++i) vdata[i] /= k;
             return *this;
         }
         
-        vec_type&       operator[](size_t i)       { return vdata[i]; }
-        const vec_type& operator[](size_t i) const { return vdata[i]; }
+        constexpr vec_type&       operator[](size_t i)       { return vdata[i]; }
+        constexpr const vec_type& operator[](size_t i) const { return vdata[i]; }
 
         ~basic_matrix() = default;
 
     };
-// Undef all helper macros.
-#undef SBEG_PTR
-#undef SEND_PTR
-#undef RBEG_PTR
-#undef REND_PTR
 
     template <class MatrixType>
-    MatrixType IdMat() {
+    constexpr MatrixType IdMat() {
         MatrixType target{};
         for (std::size_t i = 0; i < MatrixType::col; ++i)
             for (std::size_t j = 0; j < MatrixType::row; ++j)
@@ -103,27 +103,27 @@ namespace force::math {
     template <typename Ty,
         std::size_t Col, std::size_t Row,
         class VecPipeT>
-    [[nodiscard]] basic_matrix<Ty, Col, Row, VecPipeT> operator+(const basic_matrix<Ty, Col, Row, VecPipeT>& a,
+    [[nodiscard]] constexpr basic_matrix<Ty, Col, Row, VecPipeT> operator+(const basic_matrix<Ty, Col, Row, VecPipeT>& a,
                                                                  const basic_matrix<Ty, Col, Row, VecPipeT>& b) {
         basic_matrix<Ty, Col, Row, VecPipeT> M = a; M += b; return M;
     }
     template <typename Ty,
         std::size_t Col, std::size_t Row,
         class VecPipeT>
-    [[nodiscard]] basic_matrix<Ty, Col, Row, VecPipeT> operator-(const basic_matrix<Ty, Col, Row, VecPipeT>& a,
+    [[nodiscard]] constexpr basic_matrix<Ty, Col, Row, VecPipeT> operator-(const basic_matrix<Ty, Col, Row, VecPipeT>& a,
                                                                  const basic_matrix<Ty, Col, Row, VecPipeT>& b) {
         basic_matrix<Ty, Col, Row, VecPipeT> M = a; M -= b; return M;
     }
     template <typename Ty,
         std::size_t Col, std::size_t Row,
         class VecPipeT>
-    [[nodiscard]] basic_matrix<Ty, Col, Row, VecPipeT> operator*(const basic_matrix<Ty, Col, Row, VecPipeT>& m, const Ty& v) {
+    [[nodiscard]] constexpr basic_matrix<Ty, Col, Row, VecPipeT> operator*(const basic_matrix<Ty, Col, Row, VecPipeT>& m, const Ty& v) {
         basic_matrix<Ty, Col, Row, VecPipeT> M = m; M *= v; return M;
     }
     template <typename Ty,
         std::size_t Col, std::size_t Row,
         class VecPipeT>
-    [[nodiscard]] basic_matrix<Ty, Col, Row, VecPipeT> operator/(const basic_matrix<Ty, Col, Row, VecPipeT>& m, const Ty& v) {
+    [[nodiscard]] constexpr basic_matrix<Ty, Col, Row, VecPipeT> operator/(const basic_matrix<Ty, Col, Row, VecPipeT>& m, const Ty& v) {
         basic_matrix<Ty, Col, Row, VecPipeT> M = m; M /= v; return M;
     }
      // Notice, if you want to do Vector multiplication
@@ -131,20 +131,24 @@ namespace force::math {
     template <typename Ty,
         std::size_t Col, std::size_t Row, std::size_t OutDim,
         class VecPipeT>
-    [[nodiscard]] basic_matrix<Ty, Col, OutDim, VecPipeT> operator*(const basic_matrix<Ty, Col, Row, VecPipeT>& a,
+    [[nodiscard]] constexpr basic_matrix<Ty, Col, OutDim, VecPipeT> operator*(const basic_matrix<Ty, Col, Row, VecPipeT>& a,
                                                                     const basic_matrix<Ty, Row, OutDim, VecPipeT>& b) {
         basic_matrix<Ty, Col, OutDim, VecPipeT> target{};
-        #pragma omp simd
-        for (std::size_t i = 0; i < Col; ++i) {
-            #pragma omp simd
-            for (std::size_t j = 0; j < OutDim; ++j) {
-                auto s = static_cast<Ty>(0);
-                #pragma omp simd
-                for (std::size_t k = 0; k < Row; ++k)
-                    s += a[i][k] * b[k][j];
-                target[i][j] = s;
+        if constexpr (std::is_same_v<Ty, float32_t> && Col * Row * OutDim >= Mat_gemm_threshold) {
+            if (!std::is_constant_evaluated()) {
+                Mat_gemm(a.adata, Row, b.adata, OutDim, target.adata, OutDim, Col, Row, OutDim);
+                return target;
             }
         }
+        // i-k-j order, the inner loop walks rows of b and target instead of
+        // striding down a column of b. Same summation order per element.
+        for (std::size_t i = 0; i < Col; ++i)
+            for (std::size_t k = 0; k < Row; ++k) {
+                const Ty s = a[i][k];
+                #pragma omp simd
+                for (std::size_t j = 0; j < OutDim; ++j)
+                    target[i][j] += s * b[k][j];
+            }
         return target;
     }
     // Verctor right multiplication.
@@ -152,7 +156,7 @@ namespace force::math {
     template <typename Ty,
         std::size_t Col, std::size_t Row,
         class VecPipeT>
-    [[nodiscard]] basic_vector<Ty, Row, VecPipeT> operator*(const basic_matrix<Ty, Col, Row, VecPipeT>& m,
+    [[nodiscard]] constexpr basic_vector<Ty, Row, VecPipeT> operator*(const basic_matrix<Ty, Col, Row, VecPipeT>& m,
                                                             const basic_vector<Ty, Row, VecPipeT>& v) {
         basic_vector<Ty, Row, VecPipeT> target{};
         for (std::size_t i = 0; i < Col; ++i) {
@@ -168,7 +172,7 @@ namespace force::math {
     template <typename Ty,
         std::size_t Col, std::size_t Row,
         class VecPipeT>
-    [[nodiscard]] basic_vector<Ty, Col, VecPipeT> operator*(const basic_vector<Ty, Col, VecPipeT>& v,
+    [[nodiscard]] constexpr basic_vector<Ty, Col, VecPipeT> operator*(const basic_vector<Ty, Col, VecPipeT>& v,
                                                             const basic_matrix<Ty, Col, Row, VecPipeT>& m) {
         basic_vector<Ty, Col, VecPipeT> target{};
         for (std::size_t i = 0; i < Row; ++i) {
@@ -182,11 +186,91 @@ namespace force::math {
     template <typename Ty,
         std::size_t Col, std::size_t Row,
         class VecPipeT>
-    [[nodiscard]] basic_matrix<Ty, Row, Col, VecPipeT> transpose(const basic_matrix<Ty, Col, Row, VecPipeT>& m) {
+    [[nodiscard]] constexpr basic_matrix<Ty, Row, Col, VecPipeT> transpose(const basic_matrix<Ty, Col, Row, VecPipeT>& m) {
         basic_matrix<Ty, Row, Col, VecPipeT> target{};
         for (std::size_t i = 0; i < Col; ++i)
             for (std::size_t j = 0; j < Row; ++j)
                 target[j][i] = m[i][j];
         return target;
     }
-} //!namespace force::math
\ No newline at end of file
+    // Gaussian elimination with partial pivoting, works for any size.
+    // mat4x4f and mat3x3f have simd overloads (simd_mat4x4f.hpp).
+    template <typename Ty,
+        std::size_t Dim,
+        class VecPipeT>
+    [[nodiscard]] constexpr Ty determinant(const basic_matrix<Ty, Dim, Dim, VecPipeT>& m) {
+        basic_matrix<Ty, Dim, Dim, VecPipeT> a = m;
+        Ty d = static_cast<Ty>(1);
+        for (std::size_t c = 0; c < Dim; ++c) {
+            std::size_t p = c;
+            for (std::size_t r = c + 1; r < Dim; ++r)
+                if ((a[r][c] < 0 ? -a[r][c] : a[r][c]) > (a[p][c] < 0 ? -a[p][c] : a[p][c])) p = r;
+            if (a[p][c] == static_cast<Ty>(0)) return static_cast<Ty>(0);
+            if (p != c) {
+                const auto t = a[p]; a[p] = a[c]; a[c] = t;
+                d = -d;
+            }
+            d *= a[c][c];
+            for (std::size_t r = c + 1; r < Dim; ++r) {
+                const Ty f = a[r][c] / a[c][c];
+                for (std::size_t k = c; k < Dim; ++k) a[r][k] -= f * a[c][k];
+            }
+        }
+        return d;
+    }
+    // Gauss-Jordan with partial pivoting. A singular matrix gives inf or nan
+    // (and doesn't compile in a constant expression), check determinant first
+    // when that can happen.
+    template <typename Ty,
+        std::size_t Dim,
+        class VecPipeT>
+    [[nodiscard]] constexpr basic_matrix<Ty, Dim, Dim, VecPipeT> inverse(const basic_matrix<Ty, Dim, Dim, VecPipeT>& m) {
+        using mat = basic_matrix<Ty, Dim, Dim, VecPipeT>;
+        mat a = m;
+        mat target = IdMat<mat>();
+        for (std::size_t c = 0; c < Dim; ++c) {
+            std::size_t p = c;
+            for (std::size_t r = c + 1; r < Dim; ++r)
+                if ((a[r][c] < 0 ? -a[r][c] : a[r][c]) > (a[p][c] < 0 ? -a[p][c] : a[p][c])) p = r;
+            if (p != c) {
+                auto t = a[p]; a[p] = a[c]; a[c] = t;
+                t = target[p]; target[p] = target[c]; target[c] = t;
+            }
+            const Ty k = static_cast<Ty>(1) / a[c][c];
+            for (std::size_t j = 0; j < Dim; ++j) { a[c][j] *= k; target[c][j] *= k; }
+            for (std::size_t r = 0; r < Dim; ++r) {
+                if (r == c) continue;
+                const Ty f = a[r][c];
+                for (std::size_t j = 0; j < Dim; ++j) { a[r][j] -= f * a[c][j]; target[r][j] -= f * target[c][j]; }
+            }
+        }
+        return target;
+    }
+    // Inverse of an affine transform whose linear part has orthogonal columns,
+    // which is what matrices::translate, rotate and scale multiplied in T * R * S
+    // order build (gaze too). The linear part inverts to its transpose with row i
+    // divided by the squared length of column i, the translation t to minus
+    // that times t. Shears, or S * R with uneven scales, need inverse().
+    template <typename Ty,
+        std::size_t Dim,
+        class VecPipeT>
+    [[nodiscard]] constexpr basic_matrix<Ty, Dim, Dim, VecPipeT> affine_inverse(const basic_matrix<Ty, Dim, Dim, VecPipeT>& m) {
+        constexpr std::size_t N = Dim - 1;
+        auto target = IdMat<basic_matrix<Ty, Dim, Dim, VecPipeT>>();
+        for (std::size_t i = 0; i < N; ++i) {
+            auto s = static_cast<Ty>(0);
+            for (std::size_t k = 0; k < N; ++k) s += m[k][i] * m[k][i];
+            for (std::size_t j = 0; j < N; ++j) target[i][j] = m[j][i] / s;
+        }
+        for (std::size_t i = 0; i < N; ++i) {
+            auto t = static_cast<Ty>(0);
+            for (std::size_t j = 0; j < N; ++j) t += target[i][j] * m[j][N];
+            target[i][N] = -t;
+        }
+        return target;
+    }
+} //!namespace force::math
+
+#if FMA_ARCH & FMA_ARCH_X86
+#include "simd_mat4x4f.hpp"
+#endif
@@ -1,6 +1,61 @@
 #pragma once
 #include <xutility> // for min copy and move.
+#include <type_traits>
+#include <utility>
 namespace force::math {
+    // Vectors, matrices and pipes are plain data: copied with memcpy, and
+    // small ones passed in registers. The headers static_assert it.
+    template <class T>
+    concept Plain_value = std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>;
+
+    // Non-owning pipe, what *v gives back. It keeps a pointer to every
+    // element of a concatenation and copies nothing, the Vector built
+    // from it reads its sources directly:
+    //
+    //     vec4f v = *p3 | 1.f;    // p3.x, p3.y, p3.z, 1 straight into v
+    //
+    // Every step is unrolled over MaxSize, so once inlined the pointers
+    // fold away and only the loads are left. It points at its sources
+    // (scalars too), so like lazy() use it within the full expression.
+    // basic_pipe is the owning version.
+    template <typename Ty, std::size_t MaxSize>
+    class basic_pipe_view {
+    public:
+        const Ty*   pdata[MaxSize];
+        std::size_t vsize;
+
+        using value_type = Ty;
+        static constexpr std::size_t max_size = MaxSize;
+
+        constexpr basic_pipe_view(const value_type* d, std::size_t s) : pdata{}, vsize(s) {
+            Unrolled([&](std::size_t i) { if (i < s) pdata[i] = d + i; });
+        }
+
+        constexpr basic_pipe_view& operator|=(const value_type& v) {
+            if (vsize > max_size - 1) throw "Too large to combine a Vector.";
+            pdata[vsize++] = &v;
+            return *this;
+        }
+        constexpr basic_pipe_view& operator|=(const basic_pipe_view& v) {
+            if (vsize + v.vsize > max_size) throw "Too large to combine a Vector.";
+            Unrolled([&](std::size_t i) { if (i < v.vsize) pdata[vsize + i] = v.pdata[i]; });
+            vsize += v.vsize;
+            return *this;
+        }
+        constexpr const value_type& operator[](std::size_t i) const { return *pdata[i]; }
+        // Copies the first min(n, vsize) elements to dst.
+        constexpr void copy_to(value_type* dst, std::size_t n) const {
+            Unrolled([&](std::size_t i) { if (i < n && i < vsize) dst[i] = *pdata[i]; });
+        }
+
+    private:
+        // f(0) ... f(MaxSize - 1) written out, not left to the optimizer.
+        template <class Fn>
+        static constexpr void Unrolled(Fn&& f) {
+            [&]<std::size_t ... I>(std::index_sequence<I...>) { (f(I), ...); }(std::make_index_sequence<MaxSize>{});
+        }
+    };
+
     // Vector pipe is used to do conversion between Vectors.
     // This class has now extra pay off because it's very light.
     template <typename Ty, std::size_t MaxSize>
@@ -10,20 +65,23 @@ namespace force::math {
         std::size_t vsize;
 
         using value_type = Ty;
+        using view_type  = basic_pipe_view<Ty, MaxSize>;
         static constexpr std::size_t max_size = MaxSize;
 
         constexpr basic_pipe(const value_type* d, size_t s) {
             vsize = s;
             std::copy(d, d + vsize, vdata);
         }
-        basic_pipe(const basic_pipe& right) {
-            std::copy(right.vdata, right.vdata + std::min(vsize, right.vsize), vdata);
-            vsize = right.vsize;
-        }
-        basic_pipe(basic_pipe&& right) noexcept {
-            std::move(right.vdata, right.vdata + std::min(vsize, right.vsize), vdata);
-            vsize = right.vsize;
+        // Keeps a view's elements, e.g. pipe4f p = *v;
+        constexpr basic_pipe(const view_type& v) {
+            vsize = v.vsize;
+            v.copy_to(vdata, vsize);
         }
+        // Whole array copies, the unused tail included.
+        basic_pipe(const basic_pipe& right)            = default;
+        basic_pipe(basic_pipe&& right)                 = default;
+        basic_pipe& operator=(const basic_pipe& right) = default;
+        basic_pipe& operator=(basic_pipe&& right)      = default;
         // Append operator can use to cat two basic_pipe.
         // Vectors don't have mod operations so this operator is fine. 
         basic_pipe& operator|=(const value_type& v) {
@@ -55,4 +113,18 @@ namespace force::math {
     [[nodiscard]] constexpr basic_pipe<Ty, MaxSize> operator|(const Ty& a, const basic_pipe<Ty, MaxSize>& b) {
         basic_pipe<Ty, MaxSize>v(&a, 1); v |= b; return v;
     }
+    // Same operators for views, they only collect pointers.
+    template <typename Ty, std::size_t MaxSize>
+    [[nodiscard]] constexpr basic_pipe_view<Ty, MaxSize> operator|(const basic_pipe_view<Ty, MaxSize>& a, const Ty& b) {
+        basic_pipe_view<Ty, MaxSize> v(a); v |= b; return v;
+    }
+    template <typename Ty, std::size_t MaxSize>
+    [[nodiscard]] constexpr basic_pipe_view<Ty, MaxSize> operator|(const basic_pipe_view<Ty, MaxSize>& a,
+        const basic_pipe_view<Ty, MaxSize>& b) {
+        basic_pipe_view<Ty, MaxSize> v(a); v |= b; return v;
+    }
+    template <typename Ty, std::size_t MaxSize>
+    [[nodiscard]] constexpr basic_pipe_view<Ty, MaxSize> operator|(const Ty& a, const basic_pipe_view<Ty, MaxSize>& b) {
+        basic_pipe_view<Ty, MaxSize> v(&a, 1); v |= b; return v;
+    }
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "primary.hpp"
 #include "pipe.hpp"
+#include "expression.hpp"
 namespace force::math {
     // basic_vector class is the template for all Vectors.
     // Ty is the element type and Dimension is the array size.
@@ -13,77 +14,108 @@ namespace force::math {
         Ty vdata[Dimension];
         using value_type = Ty;
         using pipe_type  = VecPipeT;
+        using view_type  = typename VecPipeT::view_type;
 
         static constexpr std::size_t dimension = Dimension;
 
-        basic_vector() {
+        constexpr basic_vector() {
             std::fill(vdata, vdata + dimension, static_cast<value_type>(0));
         }
         // Initializer_list can copy elements to Data.
         // It's safe if you don't pass in any parameter or you list's len
         // is greater than Vector's actual dimension.
-        basic_vector(std::initializer_list<value_type> lst) {
+        constexpr basic_vector(std::initializer_list<value_type> lst) {
             std::fill(vdata, vdata + dimension, static_cast<value_type>(0));
             std::copy(lst.begin(), lst.end(), vdata);
         }
         // pipe constructor can use to do conversions.
-        basic_vector(const pipe_type& v) {
+        constexpr basic_vector(const pipe_type& v) {
             std::fill(vdata, vdata + dimension, static_cast<value_type>(0));
             std::copy(v.vdata, v.vdata + std::min(dimension, v.vsize), vdata);
         }
-        basic_vector(const basic_vector& right) noexcept {
-            std::copy(right.vdata, right.vdata + dimension, vdata);
-        }
-        basic_vector(basic_vector&& right)      noexcept {
-            std::move(right.vdata, right.vdata + dimension, vdata);
+        // Views are read in place, *v3 | 1.f builds a vec4f with no pipe in between.
+        constexpr basic_vector(const view_type& v) {
+            std::fill(vdata, vdata + dimension, static_cast<value_type>(0));
+            v.copy_to(vdata, dimension);
         }
+        // Copies are trivial (memcpy, small vectors go in registers).
+        constexpr basic_vector(const basic_vector& right)            = default;
+        constexpr basic_vector(basic_vector&& right)                 = default;
+        constexpr basic_vector& operator=(const basic_vector& right) = default;
+        constexpr basic_vector& operator=(basic_vector&& right)      = default;
         // operator= can use to assign value without using constructors.
-        basic_vector& operator=(const basic_vector& right) {
-            std::copy(right.vdata, right.vdata + dimension, vdata);
-            return *this;
-        }
-        basic_vector& operator=(const pipe_type& v) {
+        constexpr basic_vector& operator=(const pipe_type& v) {
             std::copy(v.vdata, v.vdata + std::min(dimension, v.vsize), vdata);
             return *this;
         }
+        // The view may point into *this (v = 1.f | *v), so it goes through a copy.
+        constexpr basic_vector& operator=(const view_type& v) {
+            basic_vector tmp(*this);
+            v.copy_to(tmp.vdata, dimension);
+            return *this = tmp;
+        }
+        // Lazy expressions (see expression.hpp) are evaluated here in one loop.
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_vector>
+        basic_vector(const E& e)                { Expr_assign<Expr_set>(vdata, e); }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_vector>
+        basic_vector& operator=(const E& e)     { Expr_assign<Expr_set>(vdata, e); return *this; }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_vector>
+        basic_vector& operator+=(const E& e)    { Expr_assign<Expr_add>(vdata, e); return *this; }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_vector>
+        basic_vector& operator-=(const E& e)    { Expr_assign<Expr_sub>(vdata, e); return *this; }
         // All commands below can turn on simd optimization by default.
         // You don't have to use simd macros to turn them on any more - they are autoMaticly.
-        basic_vector& operator+=(const basic_vector& right) {
+        constexpr basic_vector& operator+=(const basic_vector& right) {
             #pragma omp simd
             for (std::size_t i = 0; i < dimension; ++i) vdata[i] += right.vdata[i];
             return *this;
         }
-        basic_vector& operator-=(const basic_vector& right) {
+        constexpr basic_vector& operator-=(const basic_vector& right) {
             #pragma omp simd
             for (std::size_t i = 0; i < dimension; ++i) vdata[i] -= right.vdata[i];
             return *this;
         }
-        basic_vector& operator*=(const value_type& k) {
+        constexpr basic_vector& operator*=(const value_type& k) {
             #pragma omp simd
             for (std::size_t i = 0; i < dimension; ++i) vdata[i] *= k;
             return *this;
         }
-        basic_vector& operator/=(const value_type& k) {
+        constexpr basic_vector& operator/=(const value_type& k) {
             #pragma omp simd
             for (std::size_t i = 0; i < dimension; ++i) vdata[i] /= k;
             return *this;
         }
-        value_type&       operator[](size_t i)       { return  vdata[i]; }
-        const value_type& operator[](size_t i) const { return  vdata[i]; }
-        // Dereference operator returns the pipe required.
+        constexpr value_type&       operator[](size_t i)       { return  vdata[i]; }
+        constexpr const value_type& operator[](size_t i) const { return  vdata[i]; }
+        // Dereference operator returns a view of the pipe required.
         // Vectors can do conversions with pipe_type.
         // Only Vectors has the same pipe_type can do conversions.
-        pipe_type         operator*() const               { return pipe_type(vdata, dimension); }
+        constexpr view_type         operator*() const               { return view_type(vdata, dimension); }
         // Shuffle operator can give back a new Vector using this Vector to construct.
         // To use this just simply give ArgDim parameter(this is neccesarry) and give in initalizer_list
         // Which has the exact same size as ArgDim.
         template <typename ... Indecies, std::size_t ArgDim = sizeof...(Indecies)>
-        basic_vector<Ty, ArgDim, VecPipeT>        operator()(Indecies ... idx) const {
+        constexpr basic_vector<Ty, ArgDim, VecPipeT>        operator()(Indecies ... idx) const {
             basic_vector<Ty, ArgDim, VecPipeT>  rVec{};
             std::initializer_list<std::size_t>  ids = { (std::size_t)idx... };
             for (std::size_t i = 0; i < ArgDim; ++i) rVec[i] = vdata[*(ids.begin() + i)];
             return rVec;
         }
+        // Compile-time version of the shuffle operator, v.swizzle<2, 1, 0>().
+        // Indices are checked and the copy is unrolled, no list and no loop.
+        template <std::size_t ... I>
+        constexpr basic_vector<Ty, sizeof...(I), VecPipeT>  swizzle() const {
+            static_assert(sizeof...(I) > 0 && ((I < Dimension) && ...), "Swizzle index out of range!");
+            basic_vector<Ty, sizeof...(I), VecPipeT> rVec;
+            std::size_t k = 0;
+            ((rVec.vdata[k++] = vdata[I]), ...);
+            return rVec;
+        }
+        constexpr auto xy()  const { return swizzle<0, 1>(); }
+        constexpr auto xyz() const { return swizzle<0, 1, 2>(); }
+        // Rotations used by cross products.
+        constexpr auto yzx() const { return swizzle<1, 2, 0>(); }
+        constexpr auto zxy() const { return swizzle<2, 0, 1>(); }
 
         // Since there is no dynamic allocation
         // The deconstructor needs to do nothing.
@@ -91,44 +123,76 @@ namespace force::math {
     };
 
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    [[nodiscard]] const basic_vector<Ty, Dimension, VecPipeT> operator+(const basic_vector<Ty, Dimension, VecPipeT>& a,
+    [[nodiscard]] constexpr const basic_vector<Ty, Dimension, VecPipeT> operator+(const basic_vector<Ty, Dimension, VecPipeT>& a,
         const basic_vector<Ty, Dimension, VecPipeT>& b) {
         basic_vector<Ty, Dimension, VecPipeT> tmp(a);
         tmp += b;
         return tmp;
     }
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    [[nodiscard]] const basic_vector<Ty, Dimension, VecPipeT> operator-(const basic_vector<Ty, Dimension, VecPipeT>& a,
+    [[nodiscard]] constexpr const basic_vector<Ty, Dimension, VecPipeT> operator-(const basic_vector<Ty, Dimension, VecPipeT>& a,
         const basic_vector<Ty, Dimension, VecPipeT>& b) {
         basic_vector<Ty, Dimension, VecPipeT> tmp(a);
         tmp -= b;
         return tmp;
     }
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    [[nodiscard]] const basic_vector<Ty, Dimension, VecPipeT> operator*(const basic_vector<Ty, Dimension, VecPipeT>& a, Ty k) {
+    [[nodiscard]] constexpr const basic_vector<Ty, Dimension, VecPipeT> operator*(const basic_vector<Ty, Dimension, VecPipeT>& a, Ty k) {
         basic_vector<Ty, Dimension, VecPipeT> tmp(a);
         tmp *= k;
         return tmp;
     }
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    [[nodiscard]] const basic_vector<Ty, Dimension, VecPipeT> operator/(const basic_vector<Ty, Dimension, VecPipeT>& a, Ty k) {
+    [[nodiscard]] constexpr const basic_vector<Ty, Dimension, VecPipeT> operator/(const basic_vector<Ty, Dimension, VecPipeT>& a, Ty k) {
         basic_vector<Ty, Dimension, VecPipeT> tmp(a);
         tmp /= k;
         return tmp;
     }
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    [[nodiscard]] const basic_vector<Ty, Dimension, VecPipeT> operator+(const basic_vector<Ty, Dimension, VecPipeT>& a) {
+    [[nodiscard]] constexpr const basic_vector<Ty, Dimension, VecPipeT> operator+(const basic_vector<Ty, Dimension, VecPipeT>& a) {
         return a;
     }
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    [[nodiscard]] const basic_vector<Ty, Dimension, VecPipeT> operator-(const basic_vector<Ty, Dimension, VecPipeT>& a) {
+    [[nodiscard]] constexpr const basic_vector<Ty, Dimension, VecPipeT> operator-(const basic_vector<Ty, Dimension, VecPipeT>& a) {
         basic_vector<Ty, Dimension, VecPipeT> v{ static_cast<Ty>(0) }; v -= a; return v;
     }
+    // dst[Offset + i] = src[i] for i < N, written out like swizzle().
+    template <std::size_t Offset, std::size_t N, typename Ty>
+    constexpr void Vec_place(Ty* dst, const Ty* src) {
+        [&]<std::size_t ... I>(std::index_sequence<I...>) { ((dst[Offset + I] = src[I]), ...); }(std::make_index_sequence<N>{});
+    }
+    // Static concatenation, v3 | 1.f is a vec4f. Unlike *v3 | 1.f the size is
+    // worked out in the type: no size field, no branch, no throw, and a result
+    // larger than the pipe doesn't compile.
+    template <typename Ty, std::size_t D1, std::size_t D2, class VecPipeT> requires (D1 + D2 <= VecPipeT::max_size)
+    [[nodiscard]] constexpr basic_vector<Ty, D1 + D2, VecPipeT> operator|(const basic_vector<Ty, D1, VecPipeT>& a,
+        const basic_vector<Ty, D2, VecPipeT>& b) {
+        basic_vector<Ty, D1 + D2, VecPipeT> v;
+        Vec_place<0, D1>(v.vdata, a.vdata);
+        Vec_place<D1, D2>(v.vdata, b.vdata);
+        return v;
+    }
+    template <typename Ty, std::size_t Dimension, class VecPipeT> requires (Dimension < VecPipeT::max_size)
+    [[nodiscard]] constexpr basic_vector<Ty, Dimension + 1, VecPipeT> operator|(const basic_vector<Ty, Dimension, VecPipeT>& a,
+        const std::type_identity_t<Ty>& k) {
+        basic_vector<Ty, Dimension + 1, VecPipeT> v;
+        Vec_place<0, Dimension>(v.vdata, a.vdata);
+        v.vdata[Dimension] = k;
+        return v;
+    }
+    template <typename Ty, std::size_t Dimension, class VecPipeT> requires (Dimension < VecPipeT::max_size)
+    [[nodiscard]] constexpr basic_vector<Ty, Dimension + 1, VecPipeT> operator|(const std::type_identity_t<Ty>& k,
+        const basic_vector<Ty, Dimension, VecPipeT>& a) {
+        basic_vector<Ty, Dimension + 1, VecPipeT> v;
+        v.vdata[0] = k;
+        Vec_place<1, Dimension>(v.vdata, a.vdata);
+        return v;
+    }
     ///////////////////////////////////
     // Algorithms for basic_vectors. //
     //////////////////////////////////
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    [[nodiscard]] bool operator==(const basic_vector<Ty, Dimension, VecPipeT>& a,
+    [[nodiscard]] constexpr bool operator==(const basic_vector<Ty, Dimension, VecPipeT>& a,
         const basic_vector<Ty, Dimension, VecPipeT>& b) {
         bool state = true;
         for (int32_t i = 0; i < Dimension; ++i)
@@ -137,7 +201,7 @@ namespace force::math {
     }
     // Two functions to do Vector calculation.
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    const Ty dot(const basic_vector<Ty, Dimension, VecPipeT>& a, const basic_vector<Ty, Dimension, VecPipeT>& b) {
+    constexpr const Ty dot(const basic_vector<Ty, Dimension, VecPipeT>& a, const basic_vector<Ty, Dimension, VecPipeT>& b) {
         auto s = static_cast<Ty>(0);
         #pragma omp simd
         for (std::size_t i = 0; i < Dimension; ++i) s += (a[i] * b[i]);
@@ -145,14 +209,14 @@ namespace force::math {
     }
     // length here is use to get the length(modulus) of a Vector.
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    const Ty length(const basic_vector<Ty, Dimension, VecPipeT>& a) {
+    constexpr const Ty length(const basic_vector<Ty, Dimension, VecPipeT>& a) {
         auto s = static_cast<Ty>(0);
         #pragma omp simd
         for (std::size_t i = 0; i < Dimension; ++i) s += (a[i] * a[i]);
         return sqrt(s);
     }
     template <typename Ty, std::size_t Dimension, class VecPipeT>
-    basic_vector<Ty, Dimension, VecPipeT> norm(const basic_vector<Ty, Dimension, VecPipeT>& a) {
+    constexpr basic_vector<Ty, Dimension, VecPipeT> norm(const basic_vector<Ty, Dimension, VecPipeT>& a) {
         auto esqd = static_cast<Ty>(0);
         #pragma omp simd
         for (std::size_t i = 0; i < Dimension; ++i) esqd += (a[i] * a[i]);
@@ -161,11 +225,16 @@ namespace force::math {
     }
     // cross product is only avalible for 3 dimensional Vectors.
     template <typename Ty, class VecPipeT>
-    basic_vector<Ty, 3, VecPipeT> cross(const basic_vector<Ty, 3, VecPipeT>& a, const basic_vector<Ty, 3, VecPipeT>& b) {
+    constexpr basic_vector<Ty, 3, VecPipeT> cross(const basic_vector<Ty, 3, VecPipeT>& a, const basic_vector<Ty, 3, VecPipeT>& b) {
         return {
             a[1] * b[2] - b[1] * a[2],
             a[2] * b[0] - b[2] * a[0],
             a[0] * b[1] - b[0] * a[1]
         };
     }
-}
\ No newline at end of file
+}
+
+#include "simd_decl.hpp"
+#if FMA_ARCH & FMA_ARCH_X86
+#include "simd_vec4f.hpp"
+#endif
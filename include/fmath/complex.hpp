@@ -23,22 +23,14 @@ namespace force::math {
             std::fill(Data, Data + 2, static_cast<Real>(0));
             std::copy(v.vdata, v.vdata + std::min(2, v.vsize), Data);
         }
-        complex(const complex& right) { 
+        constexpr complex(const typename pipe_type::view_type& v) {
             std::fill(Data, Data + 2, static_cast<Real>(0));
-            std::copy(right.Data, right.Data + 2, Data);
-        }
-        complex(complex&& right)      {
-            std::fill(Data, Data + 2, static_cast<Real>(0));
-            std::move(right.Data, right.Data + 2, Data);
-        }
-        complex& operator= (const complex& right) { 
-            std::copy(right.Data, right.Data + 2, Data);
-            return *this; 
-        }
-        complex& operator= (complex&& right) {
-            std::move(right.Data, right.Data + 2, Data);
-            return *this;
+            v.copy_to(Data, 2);
         }
+        complex(const complex& right)             = default;
+        complex(complex&& right)                  = default;
+        complex& operator= (const complex& right) = default;
+        complex& operator= (complex&& right)      = default;
 
         // All loops will be optimized when turn on release mode.
         complex& operator+=(value_type k) {
@@ -213,4 +205,6 @@ namespace force::math {
     }
 
     using complexf = complex<float32_t, pipe4f>;
+
+    static_assert(Plain_value<complexf>, "complex must stay trivially copyable!");
 }
\ No newline at end of file
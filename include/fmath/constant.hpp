@@ -11,6 +11,8 @@ namespace force::math {
     template <std::floating_point loat>
     constexpr loat halfpi = static_cast<loat>(1.5707963267948966192313216916398);
     template <std::floating_point loat>
+    constexpr loat quarterpi = static_cast<loat>(0.78539816339744830961566084581988);
+    template <std::floating_point loat>
     constexpr loat rpi    = static_cast<loat>(0.31830988618379067153776752674503);
     template <std::floating_point loat>
     constexpr loat sqrtpi = static_cast<loat>(1.7724538509055160272981674833411);
@@ -0,0 +1,309 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <type_traits>
+#include "matrix.hpp"
+#include "thread_pool.hpp"
+
+namespace force::math {
+    // Rows x cols elements stored row after row without gaps, not owned.
+    // What the dynamic kernels below work on, so dynamic_matrix,
+    // basic_matrix and plain arrays all go through them without a copy:
+    //
+    //     gemm(view(fixed_a), dynamic_b, view(fixed_c));
+    template <typename Ty>
+    struct matrix_view {
+        Ty*         data = nullptr;
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+
+        std::size_t size()                      const { return rows * cols; }
+        Ty*         operator[](std::size_t i)   const { return data + i * cols; }
+        operator matrix_view<const Ty>()        const requires (!std::is_const_v<Ty>) { return { data, rows, cols }; }
+    };
+
+    template <typename Ty, std::size_t Col, std::size_t Row, class VecPipeT>
+    matrix_view<Ty> view(basic_matrix<Ty, Col, Row, VecPipeT>& m) { return { m.adata, Col, Row }; }
+    template <typename Ty, std::size_t Col, std::size_t Row, class VecPipeT>
+    matrix_view<const Ty> view(const basic_matrix<Ty, Col, Row, VecPipeT>& m) { return { m.adata, Col, Row }; }
+    template <typename Ty, std::size_t Dimension, class VecPipeT>
+    std::span<Ty> view(basic_vector<Ty, Dimension, VecPipeT>& v) { return { v.vdata, Dimension }; }
+    template <typename Ty, std::size_t Dimension, class VecPipeT>
+    std::span<const Ty> view(const basic_vector<Ty, Dimension, VecPipeT>& v) { return { v.vdata, Dimension }; }
+
+    // Elements per chunk handed to the pool, below it one thread is faster.
+    inline constexpr std::size_t Dyn_grain = 1 << 16;
+    // Multiply-adds per chunk of a gemm or gemv.
+    inline constexpr std::size_t Dyn_gemm_grain = 1 << 20;
+
+    ///////////////////////////////////////////////////////////
+    // Kernels on views
+    // c and y must not overlap a, b or x. Sizes that don't fit throw, like
+    // a basic_pipe that overflows.
+    ///////////////////////////////////////////////////////////
+
+    // c = a * b. Rows of c (or columns when b is much wider than a is tall)
+    // are split over the pool, float goes through the blocked Mat_gemm.
+    template <typename Ty>
+    void gemm(matrix_view<const Ty> a, matrix_view<const Ty> b, matrix_view<Ty> c) {
+        if (a.cols != b.rows || c.rows != a.rows || c.cols != b.cols) throw "Matrix sizes don't match.";
+        const std::size_t work = a.rows * a.cols * b.cols;
+        const bool        wide = b.cols > 4 * a.rows;
+        const std::size_t n    = wide ? b.cols : a.rows;
+        const std::size_t unit = work / std::max<std::size_t>(n, 1);
+        Parallel_for(n, std::max<std::size_t>(1, Dyn_gemm_grain / std::max<std::size_t>(unit, 1)), [&](std::size_t begin, std::size_t end) {
+            const std::size_t i0 = wide ? 0 : begin, i1 = wide ? a.rows : end;
+            const std::size_t j0 = wide ? begin : 0, j1 = wide ? end : b.cols;
+            if constexpr (std::is_same_v<std::remove_const_t<Ty>, float32_t>) {
+                Mat_gemm(a[i0], a.cols, b.data + j0, b.cols, c[i0] + j0, c.cols, i1 - i0, a.cols, j1 - j0);
+            } else {
+                for (std::size_t i = i0; i < i1; ++i) {
+                    std::fill(c[i] + j0, c[i] + j1, static_cast<Ty>(0));
+                    for (std::size_t k = 0; k < a.cols; ++k) {
+                        const Ty s = a[i][k];
+                        #pragma omp simd
+                        for (std::size_t j = j0; j < j1; ++j) c[i][j] += s * b[k][j];
+                    }
+                }
+            }
+        });
+    }
+    // y = a * x, rows split over the pool.
+    template <typename Ty>
+    void gemv(matrix_view<const Ty> a, std::span<const Ty> x, std::span<Ty> y) {
+        if (a.cols != x.size() || a.rows != y.size()) throw "Matrix sizes don't match.";
+        Parallel_for(a.rows, std::max<std::size_t>(1, Dyn_gemm_grain / std::max<std::size_t>(a.cols, 1)), [&](std::size_t begin, std::size_t end) {
+            if constexpr (std::is_same_v<std::remove_const_t<Ty>, float32_t>) {
+                Mat_gemv(a[begin], x.data(), y.data() + begin, end - begin, a.cols);
+            } else {
+                for (std::size_t i = begin; i < end; ++i) {
+                    auto s = static_cast<Ty>(0);
+                    for (std::size_t j = 0; j < a.cols; ++j) s += a[i][j] * x[j];
+                    y[i] = s;
+                }
+            }
+        });
+    }
+    // t = a transposed, in 32 x 32 tiles so both sides stay in cache.
+    template <typename Ty>
+    void transpose(matrix_view<const Ty> a, matrix_view<Ty> t) {
+        if (t.rows != a.cols || t.cols != a.rows) throw "Matrix sizes don't match.";
+        constexpr std::size_t tile = 32;
+        const std::size_t     band = (a.rows + tile - 1) / tile;
+        Parallel_for(band, std::max<std::size_t>(1, Dyn_grain / (tile * std::max<std::size_t>(a.cols, 1))), [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i0 = begin * tile; i0 < std::min(a.rows, end * tile); i0 += tile)
+                for (std::size_t j0 = 0; j0 < a.cols; j0 += tile)
+                    for (std::size_t i = i0; i < std::min(a.rows, i0 + tile); ++i)
+                        for (std::size_t j = j0; j < std::min(a.cols, j0 + tile); ++j) t[j][i] = a[i][j];
+        });
+    }
+    // y[i] = op(a[i], b[i]) or op(a[i]) over n elements, chunks split over the pool.
+    template <typename Ty, class Op>
+    void Dyn_apply(const Ty* a, const Ty* b, Ty* y, std::size_t n, Op op) {
+        Parallel_for(n, Dyn_grain, [&](std::size_t begin, std::size_t end) {
+            #pragma omp simd
+            for (std::size_t i = begin; i < end; ++i) y[i] = op(a[i], b[i]);
+        });
+    }
+    template <typename Ty, class Op>
+    void Dyn_apply(const Ty* a, Ty* y, std::size_t n, Op op) {
+        Parallel_for(n, Dyn_grain, [&](std::size_t begin, std::size_t end) {
+            #pragma omp simd
+            for (std::size_t i = begin; i < end; ++i) y[i] = op(a[i]);
+        });
+    }
+
+    // 64 byte aligned heap array shared by dynamic_vector and dynamic_matrix.
+    template <typename Ty>
+    class Dyn_storage {
+    public:
+        static constexpr std::size_t alignment = 64;
+
+        Dyn_storage() = default;
+        explicit Dyn_storage(std::size_t n) : dsize(n) {
+            if (n) ddata = static_cast<Ty*>(::operator new(n * sizeof(Ty), std::align_val_t{ alignment }));
+            std::fill(ddata, ddata + n, static_cast<Ty>(0));
+        }
+        Dyn_storage(const Dyn_storage& right) : Dyn_storage(right.dsize) { std::copy(right.ddata, right.ddata + dsize, ddata); }
+        Dyn_storage(Dyn_storage&& right) noexcept { swap(right); }
+        Dyn_storage& operator=(Dyn_storage right) noexcept {
+            swap(right);
+            return *this;
+        }
+        ~Dyn_storage() { if (ddata) ::operator delete(ddata, std::align_val_t{ alignment }); }
+
+        void swap(Dyn_storage& right) noexcept {
+            std::swap(ddata, right.ddata);
+            std::swap(dsize, right.dsize);
+        }
+
+        Ty*         ddata = nullptr;
+        std::size_t dsize = 0;
+    };
+
+    // Vector sized at run time, on the heap and 64 byte aligned.
+    // Converts to std::span, which is its view.
+    template <typename Ty>
+    class dynamic_vector {
+    public:
+        using value_type = Ty;
+
+        dynamic_vector() = default;
+        // n zeros.
+        explicit dynamic_vector(std::size_t n) : vstore(n) {}
+        dynamic_vector(std::initializer_list<Ty> lst) : vstore(lst.size()) { std::copy(lst.begin(), lst.end(), data()); }
+        explicit dynamic_vector(std::span<const Ty> v) : vstore(v.size()) { std::copy(v.begin(), v.end(), data()); }
+        template <std::size_t Dimension, class VecPipeT>
+        explicit dynamic_vector(const basic_vector<Ty, Dimension, VecPipeT>& v) : dynamic_vector(force::math::view(v)) {}
+
+        std::size_t size()  const { return vstore.dsize; }
+        bool        empty() const { return size() == 0; }
+        Ty*         data()        { return vstore.ddata; }
+        const Ty*   data()  const { return vstore.ddata; }
+        Ty*         begin()       { return data(); }
+        Ty*         end()         { return data() + size(); }
+        const Ty*   begin() const { return data(); }
+        const Ty*   end()   const { return data() + size(); }
+
+        Ty&       operator[](std::size_t i)       { return data()[i]; }
+        const Ty& operator[](std::size_t i) const { return data()[i]; }
+
+        operator std::span<Ty>()             { return { data(), size() }; }
+        operator std::span<const Ty>() const { return { data(), size() }; }
+        std::span<Ty>       view()           { return *this; }
+        std::span<const Ty> view()     const { return *this; }
+
+        dynamic_vector& operator+=(const dynamic_vector& right) {
+            if (size() != right.size()) throw "Vector sizes don't match.";
+            Dyn_apply(data(), right.data(), data(), size(), [](Ty a, Ty b) { return a + b; });
+            return *this;
+        }
+        dynamic_vector& operator-=(const dynamic_vector& right) {
+            if (size() != right.size()) throw "Vector sizes don't match.";
+            Dyn_apply(data(), right.data(), data(), size(), [](Ty a, Ty b) { return a - b; });
+            return *this;
+        }
+        dynamic_vector& operator*=(const Ty& k) {
+            Dyn_apply(data(), data(), size(), [k](Ty a) { return a * k; });
+            return *this;
+        }
+        dynamic_vector& operator/=(const Ty& k) {
+            Dyn_apply(data(), data(), size(), [k](Ty a) { return a / k; });
+            return *this;
+        }
+
+    private:
+        Dyn_storage<Ty> vstore;
+    };
+
+    // Matrix sized at run time, rows x cols stored row after row on the heap,
+    // 64 byte aligned. Element-wise math, gemm, gemv and transpose run on the
+    // pool once they are large enough. view() and fixed<>() share the storage
+    // with the kernels above and with basic_matrix.
+    template <typename Ty>
+    class dynamic_matrix {
+    public:
+        using value_type = Ty;
+
+        dynamic_matrix() = default;
+        // rows x cols zeros.
+        dynamic_matrix(std::size_t rows, std::size_t cols) : mstore(rows * cols), mrows(rows), mcols(cols) {}
+        explicit dynamic_matrix(matrix_view<const Ty> m) : dynamic_matrix(m.rows, m.cols) { std::copy(m.data, m.data + m.size(), data()); }
+        template <std::size_t Col, std::size_t Row, class VecPipeT>
+        explicit dynamic_matrix(const basic_matrix<Ty, Col, Row, VecPipeT>& m) : dynamic_matrix(force::math::view(m)) {}
+
+        std::size_t rows()  const { return mrows; }
+        std::size_t cols()  const { return mcols; }
+        std::size_t size()  const { return mstore.dsize; }
+        bool        empty() const { return size() == 0; }
+        Ty*         data()        { return mstore.ddata; }
+        const Ty*   data()  const { return mstore.ddata; }
+
+        // Row i.
+        Ty*       operator[](std::size_t i)       { return data() + i * mcols; }
+        const Ty* operator[](std::size_t i) const { return data() + i * mcols; }
+        Ty&       operator()(std::size_t i, std::size_t j)       { return data()[i * mcols + j]; }
+        const Ty& operator()(std::size_t i, std::size_t j) const { return data()[i * mcols + j]; }
+
+        operator matrix_view<Ty>()             { return { data(), mrows, mcols }; }
+        operator matrix_view<const Ty>() const { return { data(), mrows, mcols }; }
+        matrix_view<Ty>       view()           { return *this; }
+        matrix_view<const Ty> view()     const { return *this; }
+        // The storage seen as a fixed size matrix, no copy. Mat has to be
+        // rows() x cols() of the same value_type.
+        template <class Mat>
+        Mat& fixed() {
+            static_assert(std::is_same_v<typename Mat::value_type, Ty> && sizeof(Mat) == Mat::col * Mat::row * sizeof(Ty), "Not a matrix of Ty!");
+            if (Mat::col != mrows || Mat::row != mcols) throw "Matrix sizes don't match.";
+            return *std::launder(reinterpret_cast<Mat*>(data()));
+        }
+        template <class Mat>
+        const Mat& fixed() const { return const_cast<dynamic_matrix*>(this)->template fixed<Mat>(); }
+
+        dynamic_matrix& operator+=(const dynamic_matrix& right) {
+            if (mrows != right.mrows || mcols != right.mcols) throw "Matrix sizes don't match.";
+            Dyn_apply(data(), right.data(), data(), size(), [](Ty a, Ty b) { return a + b; });
+            return *this;
+        }
+        dynamic_matrix& operator-=(const dynamic_matrix& right) {
+            if (mrows != right.mrows || mcols != right.mcols) throw "Matrix sizes don't match.";
+            Dyn_apply(data(), right.data(), data(), size(), [](Ty a, Ty b) { return a - b; });
+            return *this;
+        }
+        dynamic_matrix& operator*=(const Ty& k) {
+            Dyn_apply(data(), data(), size(), [k](Ty a) { return a * k; });
+            return *this;
+        }
+        dynamic_matrix& operator/=(const Ty& k) {
+            Dyn_apply(data(), data(), size(), [k](Ty a) { return a / k; });
+            return *this;
+        }
+
+    private:
+        Dyn_storage<Ty> mstore;
+        std::size_t     mrows = 0;
+        std::size_t     mcols = 0;
+    };
+
+    using dynamic_vecf = dynamic_vector<float32_t>;
+    using dynamic_matf = dynamic_matrix<float32_t>;
+
+    template <typename Ty>
+    [[nodiscard]] dynamic_vector<Ty> operator+(dynamic_vector<Ty> a, const dynamic_vector<Ty>& b) { return a += b; }
+    template <typename Ty>
+    [[nodiscard]] dynamic_vector<Ty> operator-(dynamic_vector<Ty> a, const dynamic_vector<Ty>& b) { return a -= b; }
+    template <typename Ty>
+    [[nodiscard]] dynamic_vector<Ty> operator*(dynamic_vector<Ty> a, const Ty& k) { return a *= k; }
+    template <typename Ty>
+    [[nodiscard]] dynamic_vector<Ty> operator/(dynamic_vector<Ty> a, const Ty& k) { return a /= k; }
+
+    template <typename Ty>
+    [[nodiscard]] dynamic_matrix<Ty> operator+(dynamic_matrix<Ty> a, const dynamic_matrix<Ty>& b) { return a += b; }
+    template <typename Ty>
+    [[nodiscard]] dynamic_matrix<Ty> operator-(dynamic_matrix<Ty> a, const dynamic_matrix<Ty>& b) { return a -= b; }
+    template <typename Ty>
+    [[nodiscard]] dynamic_matrix<Ty> operator*(dynamic_matrix<Ty> a, const Ty& k) { return a *= k; }
+    template <typename Ty>
+    [[nodiscard]] dynamic_matrix<Ty> operator/(dynamic_matrix<Ty> a, const Ty& k) { return a /= k; }
+    template <typename Ty>
+    [[nodiscard]] dynamic_matrix<Ty> operator*(const dynamic_matrix<Ty>& a, const dynamic_matrix<Ty>& b) {
+        dynamic_matrix<Ty> c(a.rows(), b.cols());
+        gemm(a.view(), b.view(), c.view());
+        return c;
+    }
+    template <typename Ty>
+    [[nodiscard]] dynamic_vector<Ty> operator*(const dynamic_matrix<Ty>& a, const dynamic_vector<Ty>& x) {
+        dynamic_vector<Ty> y(a.rows());
+        gemv(a.view(), x.view(), y.view());
+        return y;
+    }
+    template <typename Ty>
+    [[nodiscard]] dynamic_matrix<Ty> transpose(const dynamic_matrix<Ty>& a) {
+        dynamic_matrix<Ty> t(a.cols(), a.rows());
+        transpose(a.view(), t.view());
+        return t;
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+namespace force::math {
+    template <typename Ty, std::size_t Dimension, class VecPipeT>
+    class basic_vector;
+    template <typename Ty, std::size_t Col, std::size_t Row, class VecPipeT>
+    class basic_matrix;
+
+    ///////////////////////////////////////////////////////////
+    // Element-wise expression templates
+    // The operators in basic_vector.hpp and basic_matrix.hpp make a full
+    // temporary per step, so a + b * k - c walks the data three times.
+    // Wrapping one operand with lazy() makes the whole chain a tree of
+    // small nodes instead, evaluated in one fused loop when it is assigned
+    // to (or constructs) a vector or matrix:
+    //
+    //     r = lazy(a) + lazy(b) * k - lazy(c);
+    //
+    // Only element-wise math (+ - with vectors/matrices, * / with scalars
+    // and unary -). Nodes hold references, don't keep one past the full
+    // expression (auto e = lazy(a) + b; is fine only while a and b live).
+    ///////////////////////////////////////////////////////////
+
+    // Vectors and matrices seen as a flat array.
+    template <class Ty> struct Expr_storage : std::false_type {};
+    template <typename Ty, std::size_t Dimension, class VecPipeT>
+    struct Expr_storage<basic_vector<Ty, Dimension, VecPipeT>> : std::true_type {
+        static constexpr std::size_t size = Dimension;
+        static const Ty* data(const basic_vector<Ty, Dimension, VecPipeT>& v) { return v.vdata; }
+    };
+    template <typename Ty, std::size_t Col, std::size_t Row, class VecPipeT>
+    struct Expr_storage<basic_matrix<Ty, Col, Row, VecPipeT>> : std::true_type {
+        static constexpr std::size_t size = Col * Row;
+        static const Ty* data(const basic_matrix<Ty, Col, Row, VecPipeT>& m) { return m.adata; }
+    };
+
+    template <class E>
+    concept Expression = requires { typename E::expr_result; };
+    template <class E>
+    concept Expr_operand = Expression<E> || Expr_storage<E>::value;
+
+    template <class Vt>
+    struct Expr_ref {
+        using expr_result = Vt;
+        using value_type  = typename Vt::value_type;
+        static constexpr std::size_t size = Expr_storage<Vt>::size;
+
+        const value_type* p;
+
+        value_type operator[](std::size_t i) const { return p[i]; }
+    };
+    template <class L, class R, class Op>
+    struct Expr_binary {
+        using expr_result = typename L::expr_result;
+        using value_type  = typename L::value_type;
+        static constexpr std::size_t size = L::size;
+        static_assert(std::is_same_v<expr_result, typename R::expr_result>, "Expression operands must have the same type!");
+
+        L l;
+        R r;
+
+        value_type operator[](std::size_t i) const { return Op{}(l[i], r[i]); }
+    };
+    template <class E, class Op>
+    struct Expr_scalar {
+        using expr_result = typename E::expr_result;
+        using value_type  = typename E::value_type;
+        static constexpr std::size_t size = E::size;
+
+        E          e;
+        value_type k;
+
+        value_type operator[](std::size_t i) const { return Op{}(e[i], k); }
+    };
+    template <class E>
+    struct Expr_negate {
+        using expr_result = typename E::expr_result;
+        using value_type  = typename E::value_type;
+        static constexpr std::size_t size = E::size;
+
+        E e;
+
+        value_type operator[](std::size_t i) const { return -e[i]; }
+    };
+
+    struct Expr_add { template <class T> T operator()(T a, T b) const { return a + b; } };
+    struct Expr_sub { template <class T> T operator()(T a, T b) const { return a - b; } };
+    struct Expr_mul { template <class T> T operator()(T a, T b) const { return a * b; } };
+    struct Expr_div { template <class T> T operator()(T a, T b) const { return a / b; } };
+
+    // Start of a lazy chain.
+    template <class Vt> requires Expr_storage<Vt>::value
+    Expr_ref<Vt> lazy(const Vt& v) { return { Expr_storage<Vt>::data(v) }; }
+
+    // Nodes are kept by value, storage by reference.
+    template <class E>
+    auto Expr_node(const E& e) {
+        if constexpr (Expression<E>) return e;
+        else                         return lazy(e);
+    }
+
+    // At least one side has to be an expression already, plain vector
+    // arithmetic keeps its eager operators.
+    template <Expr_operand A, Expr_operand B> requires (Expression<A> || Expression<B>)
+    auto operator+(const A& a, const B& b) {
+        return Expr_binary<decltype(Expr_node(a)), decltype(Expr_node(b)), Expr_add>{ Expr_node(a), Expr_node(b) };
+    }
+    template <Expr_operand A, Expr_operand B> requires (Expression<A> || Expression<B>)
+    auto operator-(const A& a, const B& b) {
+        return Expr_binary<decltype(Expr_node(a)), decltype(Expr_node(b)), Expr_sub>{ Expr_node(a), Expr_node(b) };
+    }
+    template <Expression E>
+    auto operator*(const E& e, typename E::value_type k) { return Expr_scalar<E, Expr_mul>{ e, k }; }
+    template <Expression E>
+    auto operator*(typename E::value_type k, const E& e) { return Expr_scalar<E, Expr_mul>{ e, k }; }
+    template <Expression E>
+    auto operator/(const E& e, typename E::value_type k) { return Expr_scalar<E, Expr_div>{ e, k }; }
+    template <Expression E>
+    auto operator-(const E& e) { return Expr_negate<E>{ e }; }
+
+    // Plain store for Expr_assign, dst[i] is never read so it may be uninitialized.
+    struct Expr_set {};
+
+    // dst[i] op= e[i] in one loop, dst may appear in e.
+    template <class Op, class E>
+    void Expr_assign(typename E::value_type* dst, const E& e) {
+        #pragma omp simd
+        for (std::size_t i = 0; i < E::size; ++i) {
+            if constexpr (std::is_same_v<Op, Expr_set>) dst[i] = e[i];
+            else                                        dst[i] = Op{}(dst[i], e[i]);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <bit>
+#include <cstdint>
+#include <span>
+#include "constant.hpp"
+
+namespace force::math {
+    ///////////////////////////////////////////////////////////
+    // 16 bit storage types
+    // Half the memory and bandwidth of float32_t for data that
+    // doesn't need the precision (point clouds, normals, colors).
+    // There is no arithmetic on them on purpose, they widen to
+    // float32_t when used and math happens in float registers.
+    //
+    //              exponent  mantissa  max      precision
+    // float16_t    5         10        65504    ~3.3 digits
+    // bfloat16_t   8         7         3.4e38   ~2.4 digits
+    //
+    // Narrowing rounds to nearest even, NaN stays NaN with its sign.
+    // The payload isn't kept the same way everywhere, float16_t gives
+    // the quiet NaN 0x7e00 while the F16C bulk narrow keeps its top bits.
+    ///////////////////////////////////////////////////////////
+
+    // float32_t bits to IEEE 754 binary16 bits.
+    // Overflow goes to inf, small values to subnormals.
+    constexpr uint16_t Half_bits(float32_t f) {
+        uint32_t u = std::bit_cast<uint32_t>(f);
+        uint32_t s = (u >> 16) & 0x8000;
+        u &= 0x7fff'ffff;
+        if (u >= 0x4780'0000)                               // >= 65536, inf or NaN.
+            return static_cast<uint16_t>(s | (u > 0x7f80'0000 ? 0x7e00 : 0x7c00));
+        if (u < 0x3880'0000) {                              // < 2^-14, subnormal or zero.
+            // Adding 0.5 lines the half subnormal ulp up with the float ulp,
+            // the add itself does the rounding.
+            float32_t t = std::bit_cast<float32_t>(u) + 0.5f;
+            return static_cast<uint16_t>(s | (std::bit_cast<uint32_t>(t) - 0x3f00'0000));
+        }
+        u += 0xc800'0fff + ((u >> 13) & 1);                 // Rebias, round half to even.
+        return static_cast<uint16_t>(s | (u >> 13));
+    }
+    constexpr float32_t Half_float(uint16_t h) {
+        uint32_t s = static_cast<uint32_t>(h & 0x8000) << 16;
+        uint32_t u = static_cast<uint32_t>(h & 0x7fff) << 13;
+        uint32_t e = u & 0x0f80'0000;
+        u += 0x3800'0000;                                   // Rebias 15 to 127.
+        if (e == 0x0f80'0000) u += 0x3800'0000;             // inf or NaN, exponent to 255.
+        else if (e == 0) {                                  // Subnormal, renormalize.
+            u += 0x0080'0000;
+            u  = std::bit_cast<uint32_t>(std::bit_cast<float32_t>(u) - std::bit_cast<float32_t>(0x3880'0000u));
+        }
+        return std::bit_cast<float32_t>(u | s);
+    }
+    // float32_t bits to the top 16 bits, rounded.
+    constexpr uint16_t Bf16_bits(float32_t f) {
+        uint32_t u = std::bit_cast<uint32_t>(f);
+        if ((u & 0x7fff'ffff) > 0x7f80'0000) return static_cast<uint16_t>((u >> 16) | 0x40);
+        return static_cast<uint16_t>((u + 0x7fff + ((u >> 16) & 1)) >> 16);
+    }
+    constexpr float32_t Bf16_float(uint16_t b) {
+        return std::bit_cast<float32_t>(static_cast<uint32_t>(b) << 16);
+    }
+
+    struct float16_t {
+        uint16_t bits;
+
+        float16_t() = default;
+        constexpr float16_t(float32_t f) : bits(Half_bits(f)) {}
+        constexpr operator float32_t() const { return Half_float(bits); }
+    };
+    struct bfloat16_t {
+        uint16_t bits;
+
+        bfloat16_t() = default;
+        constexpr bfloat16_t(float32_t f) : bits(Bf16_bits(f)) {}
+        constexpr operator float32_t() const { return Bf16_float(bits); }
+    };
+
+    ///////////////////////////////////////////////////////////
+    // Bulk conversion
+    // F16C/AVX2 or AVX-512 when the cpu has them (see isa in
+    // primary.hpp), else SSE2 for bfloat16_t and scalar for float16_t.
+    // Only min(from.size(), to.size()) elements are converted.
+    ///////////////////////////////////////////////////////////
+    void widen (std::span<const float16_t>  from, std::span<float32_t>  to);
+    void widen (std::span<const bfloat16_t> from, std::span<float32_t>  to);
+    void narrow(std::span<const float32_t>  from, std::span<float16_t>  to);
+    void narrow(std::span<const float32_t>  from, std::span<bfloat16_t> to);
+}
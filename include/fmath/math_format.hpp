@@ -30,6 +30,24 @@ std::ostream& operator<<(std::ostream& stream, const ::force::math::SIMDVector4<
     return stream;
 }
 #endif
+#if defined SIMD_VECTOR8x32
+template <typename Ty>
+std::ostream& operator<<(std::ostream& stream, const ::force::math::SIMDVector8<Ty>& vec) {
+    stream << '[';
+    for (size_t i = 0; i < 7; ++i) stream << vec[i] << ", ";
+    stream << vec[7] << ']';
+    return stream;
+}
+#endif
+#if defined SIMD_VECTOR16x32
+template <typename Ty>
+std::ostream& operator<<(std::ostream& stream, const ::force::math::SIMDVector16<Ty>& vec) {
+    stream << '[';
+    for (size_t i = 0; i < 15; ++i) stream << vec[i] << ", ";
+    stream << vec[15] << ']';
+    return stream;
+}
+#endif
 
 template <typename Ty, std::size_t Col, std::size_t Row, class VecPipeT>
 std::ostream& operator<<(std::ostream& stream, const ::force::math::basic_matrix<Ty, Col, Row, VecPipeT>& M) {
@@ -4,27 +4,92 @@
 // All transform matrices uses right hand coordinate system.
 // And All transform functions starts with M.
 namespace force::math {
+    // All of them are constexpr, so fixed transforms can be built at compile time:
+    //     constexpr mat4x4f proj = matrices::ortho(-1.f, 1.f, -1.f, 1.f, 0.1f, 100.f);
     namespace matrices {
         // Basic transforMation Matrix.
-        mat4x4f translate(const vec3f& v);
-        mat3x3f translate(const vec2f& v);
-        mat4x4f scale(const vec3f& v);
-        mat3x3f scale(const vec2f& v);
-        mat4x4f rotate(float32_t rad, const vec3f& k);
-        mat3x3f rotate(float32_t rad, const vec2f& k);
+        constexpr mat4x4f translate(const vec3f& v) {
+            return {
+                1.0f, 0.0f, 0.0f, v[0],
+                0.0f, 1.0f, 0.0f, v[1],
+                0.0f, 0.0f, 1.0f, v[2],
+                0.0f, 0.0f, 0.0f, 1.0f
+            };
+        }
+        constexpr mat3x3f translate(const vec2f& v) {
+            return {
+                1.0f, 0.0f, v[0],
+                0.0f, 1.0f, v[1],
+                0.0f, 0.0f, 1.0f,
+            };
+        }
+        constexpr mat4x4f scale(const vec3f& v) {
+            return {
+                v[0], 0.0f, 0.0f, 0.0f,
+                0.0f, v[1], 0.0f, 0.0f,
+                0.0f, 0.0f, v[2], 0.0f,
+                0.0f, 0.0f, 0.0f, 1.0f
+            };
+        }
+        constexpr mat3x3f scale(const vec2f& v) {
+            return { v[0], 0.0f, 0.0f, 0.0f, v[1], 0.0f, 0.0f, 0.0f, 1.0f, };
+        }
+        constexpr mat4x4f rotate(float32_t rad, const vec3f& k) {
+            mat4x4f i = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f };
+            mat4x4f Rk = { 0.0f, -k[2], k[1], 0.0f, k[2], 0.0f, -k[0], 0.0f, -k[1], k[0], 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+            float32_t s, c; sincos(rad, s, c);
+            return mat4x4f{ i } + (Rk * Rk) * (1.f - c) + Rk * s;
+        }
+        constexpr mat3x3f rotate(float32_t rad, const vec2f& k) {
+            float32_t s, c; sincos(rad, s, c);
+            return {
+                c, -s, (-c + 1) * k[0] + s * k[1],
+                s, c, -s * k[0] + (-c + 1) * k[1],
+                0,0,1
+            };
+        }
         /////////////////////////////////////////////////
         // MVP Matrices.
         /////////////////////////////////////////////////
         // Gaze Matrix is same as glm's lookAt.
         // Parameter 1 is e(eye) position and P2 is look at(a) Vector and third is u(up) direction.
         // This gaze will set front to -z and up to y and x to right. (OpenGL default)
-        mat4x4f gaze(const vec3f& e, const vec3f& a, const vec3f& u);
+        constexpr mat4x4f gaze(const vec3f& e, const vec3f& a, const vec3f& up) {
+            vec3f N = norm(a - e);
+            vec3f U = norm(cross(N, up));
+            vec3f V = cross(U, N);
+            mat4x4f M = IdMat<mat4x4f>();
+
+            M[0] = *U;
+            M[1] = *V;
+            M[2] = *(-N);
+
+            M[0][3] = -dot(U, e); M[1][3] = -dot(V, e); M[2][3] = dot(N, e);
+
+            return M;
+        }
         // Orthographic Matrix.
         // info should be a float32_t[6], the elem should be:
         // {left, right, bottom, top, near, far}
-        mat4x4f ortho(float32_t l, float32_t r, float32_t b, float32_t t, float32_t n, float32_t f);
+        constexpr mat4x4f ortho(float32_t l, float32_t r, float32_t b, float32_t t, float32_t n, float32_t f) {
+            return {
+                2 / (r - l),0,0,(-l - r) / (r - l),
+                0, 2 / (t - b),0,(-b - t) / (t - b),
+                0,0,2 / (f - n),(-n - f) / (f - n),
+                0,0,0,1
+            };
+        }
         // Perspective Matrix.
         // Parameters are: fov(ield of view) how(height / width) zn(z-near) zf(z-far)
-        mat4x4f persp(float32_t fov, float32_t how, float32_t zn, float32_t zf);
+        constexpr mat4x4f persp(float32_t fov, float32_t recpAspect, float32_t zn, float32_t zf) {
+            float32_t s, c; sincos(0.5f * fov, s, c);
+            float32_t ct = c / s;
+            return {
+                recpAspect * ct, 0.f, 0.f, 0.f,
+                0.f, ct, 0.f, 0.f,
+                0.f, 0.f, (zf + zn) / (zn - zf),-(2.f * zn * zf) / (zn - zf),
+                0.f, 0.f, 1.f, 0.f
+            };
+        }
     }
-}
\ No newline at end of file
+}
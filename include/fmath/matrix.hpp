@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 #include "basic_matrix.hpp"
 namespace force::math {
     using mat2x2f = typename basic_matrix<float32_t, 2, 2, pipe4f>;
@@ -7,4 +8,22 @@ namespace force::math {
     using mat2x2i = typename basic_matrix<int32_t, 2, 2, pipe4i>;
     using mat3x3i = typename basic_matrix<int32_t, 3, 3, pipe4i>;
     using mat4x4i = typename basic_matrix<int32_t, 4, 4, pipe4i>;
+    // 16 bit storage matrices, see half.hpp.
+    using mat3x3h = typename basic_matrix<float16_t, 3, 3, pipe4h>;
+    using mat4x4h = typename basic_matrix<float16_t, 4, 4, pipe4h>;
+
+    static_assert(Plain_value<mat2x2f> && Plain_value<mat3x3f> && Plain_value<mat4x4f> &&
+                  Plain_value<mat4x4i> && Plain_value<mat4x4h>, "Matrices must stay trivially copyable!");
+    static_assert(sizeof(mat3x3f) == 9 * sizeof(float32_t) && sizeof(mat4x4f) == 16 * sizeof(float32_t),
+                  "The batch kernels below read arrays of matrices as packed floats!");
+
+    // Batch versions over arrays of matrices, through the same isa dispatch
+    // as the float spans in primary.hpp. Each one fills min(m.size(), to.size())
+    // entries, m and to may be the same span (in place).
+    void inverse       (std::span<const mat4x4f> m, std::span<mat4x4f> to);
+    void inverse       (std::span<const mat3x3f> m, std::span<mat3x3f> to);
+    void affine_inverse(std::span<const mat4x4f> m, std::span<mat4x4f> to);
+    void affine_inverse(std::span<const mat3x3f> m, std::span<mat3x3f> to);
+    void determinant   (std::span<const mat4x4f> m, std::span<float32_t> to);
+    void determinant   (std::span<const mat3x3f> m, std::span<float32_t> to);
 } //! namespace force::math
\ No newline at end of file
@@ -1,8 +1,14 @@
 #pragma once
 #include "basic_pipe.hpp"
+#include "half.hpp"
 namespace force::math {
     // pipe types for common Vectors.
     using pipe4f = typename basic_pipe<float32_t, 4>;
     using pipe4i = typename basic_pipe<int32_t, 4>;
     using pipe4u = typename basic_pipe<uint32_t, 4>;
+    // Storage only, see half.hpp.
+    using pipe4h  = typename basic_pipe<float16_t, 4>;
+    using pipe4bf = typename basic_pipe<bfloat16_t, 4>;
+
+    static_assert(Plain_value<pipe4f> && Plain_value<pipe4i> && Plain_value<pipe4h>, "Pipes must stay trivially copyable!");
 }
@@ -1,61 +1,586 @@
 #pragma once
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
 #include "constant.hpp"
 
 namespace force::math {
-    [[nodiscard]] float32_t mod(float32_t x, float32_t y);
+    // Precision tiers, see "Precision tiers" below.
+    enum class precision { fast, standard, precise };
+
+    [[nodiscard]] constexpr float32_t mod(float32_t x, float32_t y);
     ///////////////////////
     // Rounding function
     ///////////////////////
-    [[nodiscard]] int32_t   trunc  (float32_t x);
-    [[nodiscard]] int32_t   ceil   (float32_t x);
-    [[nodiscard]] int32_t   floor  (float32_t x);
-    [[nodiscard]] int32_t   round  (float32_t x);
-    [[nodiscard]] int32_t   bround (float32_t x); // banker round
+    [[nodiscard]] constexpr int32_t   trunc  (float32_t x);
+    [[nodiscard]] constexpr int32_t   ceil   (float32_t x);
+    [[nodiscard]] constexpr int32_t   floor  (float32_t x);
+    [[nodiscard]] constexpr int32_t   round  (float32_t x);
+    [[nodiscard]] constexpr int32_t   bround (float32_t x); // banker round
     ////////////////////////
     // Arithmetic functions
     ////////////////////////
-    [[nodiscard]] float32_t abs    (float32_t x);
-    [[nodiscard]] int32_t   abs    (int32_t x);
-    [[nodiscard]] float32_t recp   (float32_t x);
-    [[nodiscard]] float32_t inv    (float32_t x);
-    [[nodiscard]] float32_t sqrt   (float32_t x);
-    [[nodiscard]] float32_t rsqrt  (float32_t x);
-    [[nodiscard]] float32_t cbrt   (float32_t x);
+    [[nodiscard]] constexpr float32_t abs    (float32_t x);
+    [[nodiscard]] constexpr int32_t   abs    (int32_t x);
+    [[nodiscard]] constexpr float32_t recp   (float32_t x);
+    [[nodiscard]] constexpr float32_t inv    (float32_t x);
+    [[nodiscard]] constexpr float32_t sqrt   (float32_t x);
+    [[nodiscard]] constexpr float32_t rsqrt  (float32_t x);
+    [[nodiscard]] constexpr float32_t cbrt   (float32_t x);
     ////////////////////////
     // Exp & log functions
     ////////////////////////
-    [[nodiscard]] float32_t      log    (float32_t x);
-    [[nodiscard]] float32_t      log2   (float32_t x);
-    [[nodiscard]] float32_t      log10  (float32_t x);
-    [[nodiscard]] float32_t      exp    (float32_t x);
-    [[nodiscard]] float32_t      exp2   (float32_t x);
-    [[nodiscard]] float32_t      exp10  (float32_t x);
-    [[nodiscard]] float32_t      loga   (float32_t a, float32_t b);
-    [[nodiscard]] float32_t      pow    (float32_t x, float32_t n);
+    [[nodiscard]] constexpr float32_t      log    (float32_t x);
+    [[nodiscard]] constexpr float32_t      log2   (float32_t x);
+    [[nodiscard]] constexpr float32_t      log10  (float32_t x);
+    [[nodiscard]] constexpr float32_t      exp    (float32_t x);
+    [[nodiscard]] constexpr float32_t      exp2   (float32_t x);
+    [[nodiscard]] constexpr float32_t      exp10  (float32_t x);
+    [[nodiscard]] constexpr float32_t      loga   (float32_t a, float32_t b);
+    [[nodiscard]] constexpr float32_t      pow    (float32_t x, float32_t n);
     //////////////////////////
     // Trignometric functions
     //////////////////////////
-    [[nodiscard]] float32_t sin   (float32_t x);
-    [[nodiscard]] float32_t cos   (float32_t x);
-    [[nodiscard]] float32_t tan   (float32_t x);
-    [[nodiscard]] float32_t cot   (float32_t x);
-    [[nodiscard]] float32_t sec   (float32_t x);
-    [[nodiscard]] float32_t csc   (float32_t x);
+    [[nodiscard]] constexpr float32_t sin   (float32_t x);
+    [[nodiscard]] constexpr float32_t cos   (float32_t x);
+    [[nodiscard]] constexpr float32_t tan   (float32_t x);
+    [[nodiscard]] constexpr float32_t cot   (float32_t x);
+    [[nodiscard]] constexpr float32_t sec   (float32_t x);
+    [[nodiscard]] constexpr float32_t csc   (float32_t x);
+    // sin and cos of the same angle sharing one range reduction.
+    constexpr void          sincos(float32_t x, float32_t& s, float32_t& c);
     //////////////////////////////
     // Arc-Trignometric functions
+    // Max error in ulp against double precision std:: (force_math_ulp,
+    // atan2 over its default 1e8 random pairs):
+    //   asin   2.6   [-1, 1], NaN outside
+    //   acos   1.4   [-1, 1], NaN outside
+    //   atan   2.8
+    //   atan2  2.9   finite y and x, atan2(0, 0) = 0, atan2(0, -0) = pi
+    //   acot   2.1   atan(1 / x), so (-pi/2, pi/2]
+    //   asec   2.9   acos(1 / x), |x| >= 1, NaN inside
+    //   acsc   3.0   asin(1 / x), |x| >= 1, NaN inside
     //////////////////////////////
-    [[nodiscard]] float32_t asin(float32_t x);
-    [[nodiscard]] float32_t acos(float32_t x);
-    [[nodiscard]] float32_t atan(float32_t x);
-    [[nodiscard]] float32_t acot(float32_t x);
-    [[nodiscard]] float32_t asec(float32_t x);
-    [[nodiscard]] float32_t acsc(float32_t x);
+    [[nodiscard]] constexpr float32_t asin (float32_t x);
+    [[nodiscard]] constexpr float32_t acos (float32_t x);
+    [[nodiscard]] constexpr float32_t atan (float32_t x);
+    [[nodiscard]] constexpr float32_t atan2(float32_t y, float32_t x);
+    [[nodiscard]] constexpr float32_t acot (float32_t x);
+    [[nodiscard]] constexpr float32_t asec (float32_t x);
+    [[nodiscard]] constexpr float32_t acsc (float32_t x);
+
+    ///////////////////////////////////////////////////////////
+    // Precision tiers
+    // sin<precision::fast>(x) picks iterations and polynomial degree
+    // at compile time, the plain overloads above are the standard tier.
+    // Max error is in ulp against double precision std:: over the range given,
+    // cycles are the latency of one call kept out of line (x86-64, gcc -O2).
+    // sin, cos and log error peaks near their zeros where only the absolute
+    // error stays small, precise keeps relative error there too.
+    //
+    //          range        fast           standard       precise
+    //                       ulp      cyc   ulp      cyc   ulp  cyc
+    // sqrt     [1e-3, 1e3]  11362    21    6.2      32    0.7  49
+    // rsqrt    [1e-3, 1e3]  28383    18    73       28    1.9  37
+    // cbrt     [-1e3, 1e3]  25104    50    50       71    0.7  92
+    // log      [1e-3, 1e3]  4.9e6    32    5062     42    1.8  49
+    // exp      [-20, 20]    2350     50    244      55    0.9  60
+    // sin      [-100, 100]  1.2e7    50    1.2e7    103   1.5  53
+    // cos      [-100, 100]  1.9e8    48    3.8e8    97    2.2  54
+    //
+    // fast     : one Newton step less, lower degree series, no triple angle.
+    // standard : the algorithms documented beside each definition below.
+    // precise  : one Newton step more or Cody-Waite reduction with exact
+    //            coefficients. sin and cos stay within 6 ulp for |x| < 1e3,
+    //            the three part pi/2 runs out of bits near 1e4 (~120 ulp).
+    ///////////////////////////////////////////////////////////
+    template <precision P> [[nodiscard]] constexpr float32_t sqrt (float32_t x);
+    template <precision P> [[nodiscard]] constexpr float32_t rsqrt(float32_t x);
+    template <precision P> [[nodiscard]] constexpr float32_t cbrt (float32_t x);
+    template <precision P> [[nodiscard]] constexpr float32_t log  (float32_t x);
+    template <precision P> [[nodiscard]] constexpr float32_t exp  (float32_t x);
+    template <precision P> [[nodiscard]] constexpr float32_t sin  (float32_t x);
+    template <precision P> [[nodiscard]] constexpr float32_t cos  (float32_t x);
+
+    ///////////////////////////////////////////////////////////
+    // Batch functions
+    // Same algorithms as above but run 4/8/16 lanes at a time.
+    // Only min(x.size(), y.size()) elements are written.
+    // x and y may be the same span (in place).
+    // The code path is picked at run time, see isa below. The avx2 and
+    // avx512 paths are built with fma contraction, so they can differ from
+    // the scalar functions in the last bit. asin and acos use the hardware
+    // square root, within 2 ulp of the scalar ones.
+    ///////////////////////////////////////////////////////////
+    void sqrt  (std::span<const float32_t> x, std::span<float32_t> y);
+    void rsqrt (std::span<const float32_t> x, std::span<float32_t> y);
+    void cbrt  (std::span<const float32_t> x, std::span<float32_t> y);
+    void log   (std::span<const float32_t> x, std::span<float32_t> y);
+    void exp   (std::span<const float32_t> x, std::span<float32_t> y);
+    void pow   (std::span<const float32_t> x, float32_t n, std::span<float32_t> y);
+    void pow   (std::span<const float32_t> x, std::span<const float32_t> n, std::span<float32_t> y);
+    void sin   (std::span<const float32_t> x, std::span<float32_t> y);
+    void cos   (std::span<const float32_t> x, std::span<float32_t> y);
+    void tan   (std::span<const float32_t> x, std::span<float32_t> y);
+    void sincos(std::span<const float32_t> x, std::span<float32_t> s, std::span<float32_t> c);
+    void asin  (std::span<const float32_t> x, std::span<float32_t> y);
+    void acos  (std::span<const float32_t> x, std::span<float32_t> y);
+    void atan  (std::span<const float32_t> x, std::span<float32_t> y);
+    void atan2 (std::span<const float32_t> y, std::span<const float32_t> x, std::span<float32_t> a);
+
+    // Instruction sets the batch functions are compiled for.
+    // avx2 also requires fma and f16c, avx512 means avx512f.
+    enum class isa { scalar, sse2, avx2, avx512 };
+
+    // Best isa both this cpu (cpuid, read once) and this build support.
+    [[nodiscard]] isa detected_isa();
+    // isa the batch functions currently run, detected_isa() unless overridden.
+    [[nodiscard]] isa active_isa();
+    // Makes the batch functions run the best path not above i that the cpu
+    // supports and returns it. Calls already running finish on the old path.
+    isa               select_isa(isa i);
 
     // Radian and angle conversion function
-    template <typename Ty> Ty radian(Ty deg) {
+    template <typename Ty> constexpr Ty radian(Ty deg) {
         return deg * (static_cast<Ty>(180) / pi<Ty>);
     }
-    template <typename Ty> Ty degree(Ty rad) {
+    template <typename Ty> constexpr Ty degree(Ty rad) {
         return rad * (pi<Ty> / static_cast<Ty>(180));
     }
+
+    /////////////////////////////////////////////////////////////////
+    // Definitions
+    // All of them are constexpr so they fold in constant expressions
+    // (tables, fixed transforms) and inline into loops at runtime.
+    /////////////////////////////////////////////////////////////////
+    constexpr float32_t mod(float32_t x, float32_t y) {
+        float32_t f = x / y;
+        int32_t   q = (int32_t)f;
+        float32_t r = (f - q) * y;
+        return r;
+    }
+    constexpr int32_t trunc(float32_t x) {
+        return static_cast<int32_t>(x);
+    }
+    constexpr int32_t ceil(float32_t x) {
+        return static_cast<int32_t>(x + 0.5f);
+    }
+    constexpr int32_t floor(float32_t x) {
+        return static_cast<int32_t>(x - 0.5f);
+    }
+    constexpr int32_t round(float32_t x) {
+        int32_t   i = std::bit_cast<int32_t>(x);
+        float32_t s = std::bit_cast<float32_t>((i & 0x8000'0000) | 0x3f80'0000);
+        return static_cast<int32_t>(x + s * 0.5f);
+    }
+    constexpr int32_t bround(float32_t x) {
+        int32_t   k = ((int32_t)x) & 1;
+        int32_t   i = std::bit_cast<int32_t>(x);
+        float32_t s = std::bit_cast<float32_t>((i & 0x8000'0000) | 0x3f80'0000);
+        return static_cast<int32_t>(x + s * ((float32_t)k - 0.5f));
+    }
+    constexpr float32_t abs(float32_t x) {
+        int32_t i = std::bit_cast<int32_t>(x);
+        i = i & 0x7fff'ffff;
+        return  std::bit_cast<float32_t>(i);
+    }
+    constexpr int32_t abs(int32_t x) {
+        return ((x >> 31) ^ x) - (x >> 31);
+    }
+    constexpr float32_t recp(float32_t x) {
+        return 1.f / x;
+    }
+    constexpr float32_t inv(float32_t x) {
+        int32_t i = std::bit_cast<int32_t>(x);
+        i = i ^ 0x8000'0000;
+        return  std::bit_cast<float32_t>(i);
+    }
+    template <precision P> constexpr float32_t sqrt(float32_t x) {
+        float32_t n = 0.5f * x;
+        // Bit approxiMation
+        int32_t   i = std::bit_cast<int32_t>(x);
+        i = 0x1fbd'1df5 + (i >> 1);
+        float32_t y = std::bit_cast<float32_t>(i);
+        // Newton method approxiMation.
+        y = 0.5f * y + n / y;
+        if constexpr (P != precision::fast)    y = 0.5f * y + n / y;
+        if constexpr (P == precision::precise) y = 0.5f * y + n / y;
+
+        return y;
+    }
+    template <precision P> constexpr float32_t rsqrt(float32_t x) {
+        float32_t n = 0.5f * x;
+
+        int32_t   i = std::bit_cast<int32_t>(x);
+        i = 0x5f37'5a86 - (i >> 1); // wtf, this is better?
+        float32_t y = std::bit_cast<float32_t>(i);
+
+        y = y * (1.5f - n * y * y);
+        if constexpr (P != precision::fast)    y = y * (1.5f - n * y * y);
+        if constexpr (P == precision::precise) y = y * (1.5f - n * y * y);
+
+        return y;
+    }
+    template <precision P> constexpr float32_t cbrt(float32_t x) {
+        // Truncated thirds are ~1e-6 off, which is the error floor of the standard tier.
+        constexpr float32_t third = P == precision::precise ? 1.f / 3.f : 0.333333f;
+        constexpr float32_t twoth = P == precision::precise ? 2.f / 3.f : 0.666666f;
+
+        int32_t   h = std::bit_cast<int32_t>(x);
+        float32_t s = std::bit_cast<float32_t>((h & 0x8000'0000) | 0x3f80'0000);
+
+        float32_t x0 = std::bit_cast<float32_t>(h & 0x7fff'ffff);
+        float32_t n = third * x0;
+
+        int32_t   i = std::bit_cast<int32_t>(x0);
+        i = 0x2a2e'5c2f + (i / 3);
+        float32_t y = std::bit_cast<float32_t>(i);
+
+        y = twoth * y + n * (1.f / (y * y));
+        y = twoth * y + n * (1.f / (y * y));
+        if constexpr (P != precision::fast) y = twoth * y + n * (1.f / (y * y));
+        if constexpr (P == precision::precise) {
+            // One last step written as a correction, y += (x / y^2 - y) / 3,
+            // so the rounding error of the sum does not build up.
+            float32_t q = x0 / (y * y);
+            y = y + (q - y) * third;
+        }
+
+        return s * y;
+    }
+    template <precision P> constexpr float32_t log(float32_t x) {
+        float32_t ln2 = 0.693'1471'8055'9945'3094'1723f;
+        // Evil floating point bit hacking.
+        int32_t   i = std::bit_cast<int32_t>(x);
+        int32_t   e = (i >> 23) - 0x7f;
+        int32_t   f = (((i << 1) & 0x00ff'ffff) >> 1) | 0x3f80'0000;
+        if constexpr (P == precision::precise) {
+            // Move m from [1, 2) to [sqrt(1/2), sqrt(2)) so t stays under 0.172.
+            int32_t k = (f >= 0x3fb5'04f3);
+            f -= k << 23;
+            e += k;
+        }
+        float32_t m = std::bit_cast<float32_t>(f);
+
+        // ApproxiMation using talor expination.
+        float32_t t = (m - 1.f) / (m + 1.f);
+        float32_t t2 = t * t;
+        if constexpr (P == precision::fast) {
+            float32_t y = 2.f * (t + t2 * t * (0.333333f + t2 * 0.2f));
+            return ln2 * (float32_t)e + y;
+        }
+        else if constexpr (P == precision::standard) {
+            float32_t y = 2.f * (t + t2 * t * (0.333333f + t2 * (0.2f + t2 * (0.142857f + t2 * (0.111111f + t2 * 0.090909f)))));
+            return ln2 * (float32_t)e + y;
+        }
+        else {
+            // ln2 split in two so e * ln2hi is exact.
+            float32_t ln2hi = 0.693'359'375f;
+            float32_t ln2lo = -2.121'944'40e-4f;
+            float32_t y = 2.f * t2 * t * (1.f / 3 + t2 * (1.f / 5 + t2 * (1.f / 7 + t2 * (1.f / 9 + t2 * (1.f / 11)))));
+            return ln2hi * (float32_t)e + (2.f * t + (ln2lo * (float32_t)e + y));
+        }
+    }
+    constexpr float32_t log2(float32_t x) {
+        float32_t rln2 = 1.4'4269'5021'6293'3349'6093f;
+        return rln2 * log(x);
+    }
+    constexpr float32_t log10(float32_t x) {
+        float32_t rln10 = 0.4'3429'4481'9032'5182'7651f;
+        return rln10 * log(x);
+    }
+    template <precision P> constexpr float32_t exp(float32_t x) {
+        if constexpr (P == precision::precise) {
+            // Round to nearest so b : [-ln2/2, ln2/2], then b = x - i * ln2 in two exact steps.
+            float32_t t = x * 1.4'4269'5040'8889'6341f;
+            int32_t   i = (int32_t)(t + std::bit_cast<float32_t>((std::bit_cast<int32_t>(t) & 0x8000'0000) | 0x3f00'0000));
+            float32_t b = (x - (float32_t)i * 0.693'359'375f) + (float32_t)i * 2.121'944'40e-4f;
+            float32_t y = 1.f + b * (1.f + b * (0.5f + b * (1.f / 6 + b * (1.f / 24 + b * (1.f / 120 + b * (1.f / 720 + b * (1.f / 5040)))))));
+            return std::bit_cast<float32_t>((i + 0x7f) << 23) * y;
+        }
+        float32_t ln2 = 0.6'9314'7182'4645'9960'9375f; // actual ieee754 value of ln2.
+        // Split exponent to interger part and floating point part.
+        // Since x = i + f
+        // 2^(x) = 2^(i + f) = 2^i * 2^f.
+        float32_t t = x / ln2;
+        // Can be replaced by split but I don't do it here.
+        int32_t   i = (int32_t)t;
+        float32_t f = t - (float32_t)i;
+
+        int32_t   a = (i + 0x7f) << 23;
+        float32_t b = ln2 * f;      // 2^f = e^(ln2 * f) = e^b
+        // Calculates e^b using talor expination since b : (-ln2, ln2)-
+        // expination can be very approxiMate.
+        float32_t y;
+        if constexpr (P == precision::fast)
+            y = 1.f + b * (1.f + b * (0.5f + b * (0.166666f + b * (0.0416666f + b * 0.0083333f))));
+        else
+            y = 1.f + b * (1.f + b * (0.5f + b * (0.166666f + b * (0.0416666f + b * (0.0083333f + b * 0.0013888f)))));
+        return std::bit_cast<float32_t>(a) * y;
+    }
+    constexpr float32_t exp2(float32_t x) {
+        float32_t ln2 = 0.6'9314'7182'4645'9960'9375f;
+        return exp(x * ln2);
+    }
+    constexpr float32_t exp10(float32_t x) {
+        float32_t ln10 = 2.3'0258'5124'9694'8242'1875f;
+        return exp(x * ln10);
+    }
+    // Log in any base.
+    constexpr float32_t loga(float32_t a, float32_t b) {
+        float32_t lnb = log(b);
+        float32_t lna = log(a);
+        return lnb / lna;
+    }
+    // Real exponent power function.
+    constexpr float32_t pow(float32_t a, float32_t b) {
+        float32_t lna = log(a);
+        return exp(b * lna);
+    }
+    // Helpers for the fast and precise sin/cos tiers.
+    // k must be non-negative, o is added to the quadrant (1 gives cos).
+    constexpr float32_t Fast_sin(float32_t k, int32_t o) {
+        float32_t f = k * 0.6366'1977'2367'5814f;          // k / (pi/2)
+        int32_t   q = (int32_t)f;
+        float32_t r = (f - q) * halfpi<float32_t>;
+        int32_t   d = (q + o) & 3;
+        float32_t t = (d & 1) ? halfpi<float32_t> - r : r;
+        float32_t t2 = t * t;
+        float32_t y = t * (1.f + t2 * (-0.1666666f + t2 * (0.0083333f - t2 * 0.000198412f)));
+        return (d & 2) ? -y : y;
+    }
+    // Cody-Waite reduction of k >= 0, r = k - q * pi/2 in [-pi/4, pi/4].
+    // pi/2 is split in three parts, the first has 8 bits so q * dp1 is exact for q < 2^16.
+    constexpr int32_t Precise_reduce(float32_t k, float32_t& r) {
+        int32_t q = (int32_t)(k * 0.6366'1977'2367'5814f + 0.5f);
+        float32_t fq = (float32_t)q;
+        r = ((k - fq * 1.570'312'5f) - fq * 4.837'512'969'970'703'1e-4f) - fq * 7.549'789'954'891'882e-8f;
+        return q;
+    }
+    constexpr float32_t Precise_sin(float32_t r) {
+        float32_t r2 = r * r;
+        return r + r * r2 * (-1.f / 6 + r2 * (1.f / 120 + r2 * (-1.f / 5040 + r2 * (1.f / 362880))));
+    }
+    constexpr float32_t Precise_cos(float32_t r) {
+        float32_t r2 = r * r;
+        return 1.f - 0.5f * r2 + r2 * r2 * (1.f / 24 + r2 * (-1.f / 720 + r2 * (1.f / 40320 + r2 * (-1.f / 3628800))));
+    }
+    template <precision P> constexpr float32_t sin(float32_t x) {
+        if constexpr (P == precision::fast)
+            return std::bit_cast<float32_t>(std::bit_cast<int32_t>(Fast_sin(abs(x), 0)) ^ (std::bit_cast<int32_t>(x) & 0x8000'0000));
+        if constexpr (P == precision::precise) {
+            float32_t r;
+            int32_t   i = std::bit_cast<int32_t>(x);
+            int32_t   d = Precise_reduce(std::bit_cast<float32_t>(i & 0x7fff'ffff), r) & 3;
+            float32_t y = (d & 1) ? Precise_cos(r) : Precise_sin(r);
+            return std::bit_cast<float32_t>(std::bit_cast<int32_t>(y) ^ ((d & 2) << 30) ^ (i & 0x8000'0000));
+        }
+
+        int32_t   i = std::bit_cast<int32_t>(x);
+        int32_t   g = (i & 0x8000'0000) | 0x3f80'0000;
+        float32_t s = std::bit_cast<float32_t>(g);               // Original angle's sign.
+        float32_t k = std::bit_cast<float32_t>(i & 0x7fff'ffff); // Absoulute value.
+        float32_t f = k / halfpi<float32_t>;                // raction is the result.
+        int32_t   q = (int32_t)f;                           // Quotient is int32_t part of f.
+        float32_t r = (f - q) * halfpi<float32_t>;          // Remainder is a the angle remainded.
+        int32_t   d = q & 3;                            // q mod 4.
+        float32_t a = 1.5f - (float32_t)d;
+        int32_t   b = std::bit_cast<int32_t>(a) & 0x7fff'ffff;   // Distance between 1.5 and 0, 1, 2, 3.
+        int32_t   e = (int32_t)(std::bit_cast<float32_t>(b) + 1.f);  // Translate sign's exponent
+        float32_t m = (r - (d & 1) * halfpi<float32_t>);    // Translate angle.
+        int32_t   p = ((e & 1) << 31) | 0x3f80'0000;
+        float32_t t = std::bit_cast<float32_t>(p) * m;           // theta is the angle translated between [-pi/2, pi/2].
+
+        float32_t h = t / 9;
+        float32_t h2 = h * h;
+        float32_t l = (((0.000027553f * h2 - 0.0001984f) * h2 + 0.0083333f) * h2 - 0.1666666f) * h * h2 + h;
+        float32_t j = l * (3.f - 4.f * l * l);
+        float32_t y = j * (3.f - 4.f * j * j);
+
+        // ix sign accoeding to original sign.
+        return s * y;
+    }
+    template <precision P> constexpr float32_t cos(float32_t x) {
+        if constexpr (P == precision::fast) return Fast_sin(abs(x), 1);
+        if constexpr (P == precision::precise) {
+            float32_t r;
+            int32_t   d = Precise_reduce(abs(x), r) & 3;
+            float32_t y = (d & 1) ? Precise_sin(r) : Precise_cos(r);
+            return std::bit_cast<float32_t>(std::bit_cast<int32_t>(y) ^ (((d + 1) & 2) << 30));
+        }
+        float32_t f = x / pi<float32_t>;
+        int32_t   q = (int32_t)f;
+        float32_t r = (f - q) * pi<float32_t>;
+        int32_t   d = q & 1;
+        float32_t s = std::bit_cast<float32_t>((d << 31) | 0x3f80'0000);
+        float32_t t = s * r + (float32_t)d * pi<float32_t>;
+        // 1/27x Talor expination approxiMation.
+        float32_t h = t / 27;
+        float32_t h2 = h * h;
+        float32_t l = (((0.000024797f * h2 - 0.001388888f) * h2 + 0.04166666f) * h2 - 0.49999999f) * h2 + 1.f;
+        // 27x angle approxiMation.
+        float32_t b = l * (4.f * l * l - 3.f);
+        float32_t e = b * (4.f * b * b - 3.f);
+        float32_t y = e * (4.f * e * e - 3.f);
+
+        return y;
+    }
+    constexpr float32_t tan(float32_t x) {
+        int32_t   i = std::bit_cast<int32_t>(x);
+        int32_t   g = (i & 0x8000'0000) | 0x3f80'0000;
+        float32_t s = std::bit_cast<float32_t>(g);
+        float32_t v = std::bit_cast<float32_t>(i & 0x7fffffff); // Absolute value.
+        float32_t f = v / halfpi<float32_t>;
+        int32_t   q = (int32_t)f;
+        float32_t r = (f - q) * halfpi<float32_t>;
+        int32_t   d = q & 1;
+        float32_t t = r - (float32_t)d * halfpi<float32_t>;
+
+        float32_t h = t / 4;
+        float32_t h2 = h * h;
+        float32_t l = h * (1.f + h2 * (0.333333f + h2 * (0.1333333f + h2 * 0.05396825f)));
+        float32_t l2 = l * l;
+        float32_t y = (4 * l * (1 - l2)) / (1 - 6 * l2 + l2 * l2);
+
+        return s * y;
+    }
+    constexpr void sincos(float32_t x, float32_t& s, float32_t& c) {
+        int32_t   i = std::bit_cast<int32_t>(x);
+        float32_t k = std::bit_cast<float32_t>(i & 0x7fff'ffff);
+        float32_t f = k / halfpi<float32_t>;
+        int32_t   q = (int32_t)f;
+        float32_t r = (f - q) * halfpi<float32_t>;          // r : [0, pi/2), reduced only once.
+        int32_t   d = q & 3;
+
+        // sin(r) and cos(r) = sin(pi/2 - r), both with the 9x expansion of sin.
+        // The two chains are independent so they overlap in the pipeline.
+        float32_t h = r / 9;
+        float32_t g = (halfpi<float32_t> - r) / 9;
+        float32_t h2 = h * h;
+        float32_t g2 = g * g;
+        float32_t l = (((0.000027553f * h2 - 0.0001984f) * h2 + 0.0083333f) * h2 - 0.1666666f) * h * h2 + h;
+        float32_t m = (((0.000027553f * g2 - 0.0001984f) * g2 + 0.0083333f) * g2 - 0.1666666f) * g * g2 + g;
+        float32_t j = l * (3.f - 4.f * l * l);
+        float32_t p = m * (3.f - 4.f * m * m);
+        float32_t sr = j * (3.f - 4.f * j * j);
+        float32_t cr = p * (3.f - 4.f * p * p);
+
+        // Quadrant d rotates (sin r, cos r): odd quadrants swap them,
+        // sin is negative in 2 and 3, cos is negative in 1 and 2.
+        float32_t a = (d & 1) ? cr : sr;
+        float32_t o = (d & 1) ? sr : cr;
+        s = std::bit_cast<float32_t>(std::bit_cast<int32_t>(a) ^ ((d & 2) << 30) ^ (i & 0x8000'0000));
+        c = std::bit_cast<float32_t>(std::bit_cast<int32_t>(o) ^ (((d + 1) & 2) << 30));
+    }
+    constexpr float32_t cot(float32_t x) {
+        return 1.f / tan(x);
+    }
+    constexpr float32_t sec(float32_t x) {
+        return 1.f / cos(x);
+    }
+    constexpr float32_t csc(float32_t x) {
+        return 1.f / sin(x);
+    }
+    // asin(t) for t = |x| in [0, 1] is big ? pi/2 - 2r : r with the r returned.
+    // Above 0.5 uses asin(t) = pi/2 - 2 asin(sqrt((1 - t) / 2)), so one
+    // polynomial in z covers the whole range without branches.
+    constexpr float32_t Asin_core(float32_t t, bool big) {
+        float32_t z = big ? 0.5f * (1.f - t) : t * t;
+        float32_t s = big ? (z > 0.f ? sqrt<precision::precise>(z) : 0.f) : t;
+        float32_t p = (((0.042163199048f * z + 0.024181311049f) * z + 0.045470025998f) * z + 0.074953002686f) * z + 0.16666752422f;
+        return s + s * z * p;
+    }
+    constexpr float32_t asin(float32_t x) {
+        int32_t   i = std::bit_cast<int32_t>(x);
+        float32_t t = std::bit_cast<float32_t>(i & 0x7fff'ffff);
+        if (t > 1.f) return std::numeric_limits<float32_t>::quiet_NaN();
+        bool      big = t > 0.5f;
+        float32_t r = Asin_core(t, big);
+        float32_t y = big ? halfpi<float32_t> - 2.f * r : r;
+        return std::bit_cast<float32_t>(std::bit_cast<int32_t>(y) | (i & 0x8000'0000));
+    }
+    constexpr float32_t acos(float32_t x) {
+        int32_t   i = std::bit_cast<int32_t>(x);
+        float32_t t = std::bit_cast<float32_t>(i & 0x7fff'ffff);
+        if (t > 1.f) return std::numeric_limits<float32_t>::quiet_NaN();
+        bool      big = t > 0.5f;
+        float32_t r = Asin_core(t, big);
+        // acos(x) = pi/2 - asin(x), folded so nothing cancels near |x| = 1.
+        float32_t n = std::bit_cast<float32_t>(std::bit_cast<int32_t>(r) | (i & 0x8000'0000));
+        float32_t b = (i < 0) ? pi<float32_t> - 2.f * r : 2.f * r;
+        return big ? b : halfpi<float32_t> - n;
+    }
+    // atan(mn / mx) for 0 <= mn <= mx, in [0, pi/4].
+    // Above tan(pi/8) it shifts by pi/4, atan(t) = pi/4 + atan((t - 1) / (t + 1)),
+    // which leaves |z| <= tan(pi/8) for a degree 9 odd polynomial.
+    constexpr float32_t Atan_core(float32_t mn, float32_t mx) {
+        bool      mid = mn > 0.41421356237f * mx;
+        float32_t num = mid ? mn - mx : mn;
+        float32_t den = mid ? mn + mx : mx;
+        float32_t z   = num / (den == 0.f ? 1.f : den);
+        float32_t z2  = z * z;
+        float32_t p   = (((0.080537444954f * z2 - 0.13877685603f) * z2 + 0.19977710648f) * z2 - 0.33332949154f) * z2 * z + z;
+        return (mid ? quarterpi<float32_t> : 0.f) + p;
+    }
+    constexpr float32_t atan(float32_t x) {
+        int32_t   i = std::bit_cast<int32_t>(x);
+        float32_t t = std::bit_cast<float32_t>(i & 0x7fff'ffff);
+        bool      inv = t > 1.f;
+        float32_t a = Atan_core(inv ? 1.f : t, inv ? t : 1.f);
+        float32_t y = inv ? halfpi<float32_t> - a : a;
+        return std::bit_cast<float32_t>(std::bit_cast<int32_t>(y) | (i & 0x8000'0000));
+    }
+    constexpr float32_t atan2(float32_t y, float32_t x) {
+        int32_t   iy = std::bit_cast<int32_t>(y);
+        int32_t   ix = std::bit_cast<int32_t>(x);
+        float32_t ay = std::bit_cast<float32_t>(iy & 0x7fff'ffff);
+        float32_t ax = std::bit_cast<float32_t>(ix & 0x7fff'ffff);
+        bool      swap = ay > ax;
+        float32_t mn = swap ? ax : ay;
+        float32_t mx = swap ? ay : ax;
+        // Keeps mn + mx in Atan_core finite, exact for numbers that large.
+        float32_t k = mx > 0x1p126f ? 0.25f : 1.f;
+        float32_t a = Atan_core(mn * k, mx * k);
+        a = swap ? halfpi<float32_t> - a : a;
+        a = (ix < 0) ? pi<float32_t> - a : a;
+        return std::bit_cast<float32_t>(std::bit_cast<int32_t>(a) | (iy & 0x8000'0000));
+    }
+    constexpr float32_t acot(float32_t x) {
+        // atan(1 / x) without rounding 1 / x, the roles of atan flipped.
+        int32_t   i = std::bit_cast<int32_t>(x);
+        float32_t t = std::bit_cast<float32_t>(i & 0x7fff'ffff);
+        bool      inv = t > 1.f;
+        float32_t a = Atan_core(inv ? 1.f : t, inv ? t : 1.f);
+        float32_t y = inv ? a : halfpi<float32_t> - a;
+        return std::bit_cast<float32_t>(std::bit_cast<int32_t>(y) | (i & 0x8000'0000));
+    }
+    // sqrt(x^2 - 1) for asec and acsc. acos(1 / x) itself would blow up the
+    // rounding of 1 / x near |x| = 1, (t - 1)(t + 1) stays exact there.
+    // Above 2^12 the -1 is below half an ulp, t also keeps t^2 from overflowing.
+    constexpr float32_t Arc_leg(float32_t t) {
+        if (t > 0x1p12f) return t;
+        float32_t u = (t - 1.f) * (t + 1.f);
+        if (u < 0.f) return std::numeric_limits<float32_t>::quiet_NaN();
+        return u > 0.f ? sqrt<precision::precise>(u) : 0.f;
+    }
+    constexpr float32_t asec(float32_t x) {
+        int32_t   i = std::bit_cast<int32_t>(x);
+        float32_t a = atan(Arc_leg(std::bit_cast<float32_t>(i & 0x7fff'ffff)));
+        return (i < 0) ? pi<float32_t> - a : a;
+    }
+    constexpr float32_t acsc(float32_t x) {
+        int32_t   i = std::bit_cast<int32_t>(x);
+        float32_t a = acot(Arc_leg(std::bit_cast<float32_t>(i & 0x7fff'ffff)));
+        return std::bit_cast<float32_t>(std::bit_cast<int32_t>(a) | (i & 0x8000'0000));
+    }
+
+    // Standard tier.
+    constexpr float32_t sqrt (float32_t x) { return sqrt<precision::standard>(x); }
+    constexpr float32_t rsqrt(float32_t x) { return rsqrt<precision::standard>(x); }
+    constexpr float32_t cbrt (float32_t x) { return cbrt<precision::standard>(x); }
+    constexpr float32_t log  (float32_t x) { return log<precision::standard>(x); }
+    constexpr float32_t exp  (float32_t x) { return exp<precision::standard>(x); }
+    constexpr float32_t sin  (float32_t x) { return sin<precision::standard>(x); }
+    constexpr float32_t cos  (float32_t x) { return cos<precision::standard>(x); }
 }
@@ -249,7 +249,7 @@
 ///////////////////////////////////////////////////////////////////////////////////
 // Instruction sets
 
-// User defines: FMA_FORCE_PURE FMA_FORCE_INTRINSICS FMA_FORCE_SSE2 FMA_FORCE_SSE3 FMA_FORCE_AVX FMA_FORCE_AVX2 FMA_FORCE_AVX2
+// User defines: FMA_FORCE_PURE FMA_FORCE_INTRINSICS FMA_FORCE_SSE2 FMA_FORCE_SSE3 FMA_FORCE_AVX FMA_FORCE_AVX2 FMA_FORCE_AVX512
 
 #define FMA_ARCH_MIPS_BIT	(0x10000000)
 #define FMA_ARCH_PPC_BIT	(0x20000000)
@@ -268,6 +268,7 @@
 #define FMA_ARCH_SSE42_BIT	(0x00000040)
 #define FMA_ARCH_AVX_BIT	(0x00000080)
 #define FMA_ARCH_AVX2_BIT	(0x00000100)
+#define FMA_ARCH_AVX512_BIT	(0x00000200)
 
 #define FMA_ARCH_UNKNOWN	(0)
 #define FMA_ARCH_X86		(FMA_ARCH_X86_BIT)
@@ -279,6 +280,7 @@
 #define FMA_ARCH_SSE42		(FMA_ARCH_SSE42_BIT | FMA_ARCH_SSE41)
 #define FMA_ARCH_AVX		(FMA_ARCH_AVX_BIT | FMA_ARCH_SSE42)
 #define FMA_ARCH_AVX2		(FMA_ARCH_AVX2_BIT | FMA_ARCH_AVX)
+#define FMA_ARCH_AVX512		(FMA_ARCH_AVX512_BIT | FMA_ARCH_AVX2)
 #define FMA_ARCH_ARM		(FMA_ARCH_ARM_BIT)
 #define FMA_ARCH_ARMV8		(FMA_ARCH_NEON_BIT | FMA_ARCH_SIMD_BIT | FMA_ARCH_ARM | FMA_ARCH_ARMV8_BIT)
 #define FMA_ARCH_NEON		(FMA_ARCH_NEON_BIT | FMA_ARCH_SIMD_BIT | FMA_ARCH_ARM)
@@ -293,33 +295,58 @@
 #	else
 #		define FMA_ARCH (FMA_ARCH_NEON)
 #	endif
-#	define FMA_FORCE_INTRINSICS
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
+#elif defined(FMA_FORCE_AVX512)
+#	define FMA_ARCH (FMA_ARCH_AVX512)
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
 #elif defined(FMA_FORCE_AVX2)
 #	define FMA_ARCH (FMA_ARCH_AVX2)
-#	define FMA_FORCE_INTRINSICS
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
 #elif defined(FMA_FORCE_AVX)
 #	define FMA_ARCH (FMA_ARCH_AVX)
-#	define FMA_FORCE_INTRINSICS
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
 #elif defined(FMA_FORCE_SSE42)
 #	define FMA_ARCH (FMA_ARCH_SSE42)
-#	define FMA_FORCE_INTRINSICS
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
 #elif defined(FMA_FORCE_SSE41)
 #	define FMA_ARCH (FMA_ARCH_SSE41)
-#	define FMA_FORCE_INTRINSICS
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
 #elif defined(FMA_FORCE_SSSE3)
 #	define FMA_ARCH (FMA_ARCH_SSSE3)
-#	define FMA_FORCE_INTRINSICS
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
 #elif defined(FMA_FORCE_SSE3)
 #	define FMA_ARCH (FMA_ARCH_SSE3)
-#	define FMA_FORCE_INTRINSICS
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
 #elif defined(FMA_FORCE_SSE2)
 #	define FMA_ARCH (FMA_ARCH_SSE2)
-#	define FMA_FORCE_INTRINSICS
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
 #elif defined(FMA_FORCE_SSE)
 #	define FMA_ARCH (FMA_ARCH_SSE)
-#	define FMA_FORCE_INTRINSICS
+#	ifndef FMA_FORCE_INTRINSICS
+#		define FMA_FORCE_INTRINSICS
+#	endif
 #elif defined(FMA_FORCE_INTRINSICS) && !defined(FMA_FORCE_XYZW_ONLY)
-#	if defined(__AVX2__)
+#	if defined(__AVX512F__)
+#		define FMA_ARCH (FMA_ARCH_AVX512)
+#	elif defined(__AVX2__)
 #		define FMA_ARCH (FMA_ARCH_AVX2)
 #	elif defined(__AVX__)
 #		define FMA_ARCH (FMA_ARCH_AVX)
@@ -382,3 +409,14 @@
 #elif FMA_ARCH & FMA_ARCH_NEON
 #	include <arm_neon.h>
 #endif//FMA_ARCH
+
+///////////////////////////////////////////////////////////////////////////////////
+// Inline mode
+
+// FORCE_INLINE_MATH (cmake option ORCE_INLINE_MATH) moves the simd definitions
+// out of force_lib into the headers, so the compiler can inline them without LTO.
+#ifdef FORCE_INLINE_MATH
+#	define FMA_INLINE inline
+#else
+#	define FMA_INLINE
+#endif
@@ -0,0 +1,187 @@
+#pragma once
+#include "basic_matrix.hpp"
+#include "simd_vec4f.hpp"
+
+namespace force::math {
+    // mat4x4f kernels. Rows of mat4x4f are vec4f, so every row already
+    // sits in an __m128 and the generic triple loops become a handful of
+    // broadcasts and multiply-adds. Picked over the templates in basic_matrix.hpp
+    // by overload resolution, results only differ by rounding (fma).
+    // Constant evaluation goes to those templates instead.
+    using Mat4f = basic_matrix<float32_t, 4, 4, pipe4f>;
+    using Mat3f = basic_matrix<float32_t, 3, 3, pipe4f>;
+    using Vec4f = basic_vector<float32_t, 4, pipe4f>;
+
+    // a * b + c, fused when the build targets AVX2 (which comes with FMA).
+    inline __m128 Mat4f_madd(__m128 a, __m128 b, __m128 c) {
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+        return _mm_fmadd_ps(a, b, c);
+#else
+        return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+    }
+    // Row v times b: v[0] * b[0] + v[1] * b[1] + v[2] * b[2] + v[3] * b[3].
+    inline __m128 Mat4f_row(__m128 v, const Mat4f& b) {
+        __m128 r = _mm_mul_ps(_mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0)), b.vdata[0].idata);
+        r = Mat4f_madd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)), b.vdata[1].idata, r);
+        r = Mat4f_madd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2)), b.vdata[2].idata, r);
+        return Mat4f_madd(_mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3)), b.vdata[3].idata, r);
+    }
+
+    // Rows straight into the registers, the zero fill of the constructor is a dead store.
+    inline Mat4f Mat4f_make(__m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+        Mat4f m{};
+        m.vdata[0].idata = r0; m.vdata[1].idata = r1; m.vdata[2].idata = r2; m.vdata[3].idata = r3;
+        return m;
+    }
+
+    [[nodiscard]] constexpr Mat4f operator*(const Mat4f& a, const Mat4f& b) {
+        if (std::is_constant_evaluated()) return operator*<float32_t, 4, 4, 4, pipe4f>(a, b);
+        return Mat4f_make(
+            Mat4f_row(a.vdata[0].idata, b),
+            Mat4f_row(a.vdata[1].idata, b),
+            Mat4f_row(a.vdata[2].idata, b),
+            Mat4f_row(a.vdata[3].idata, b));
+    }
+    // m * v, v as a column: one dot product per row.
+    [[nodiscard]] constexpr Vec4f operator*(const Mat4f& m, const Vec4f& v) {
+        if (std::is_constant_evaluated()) return operator*<float32_t, 4, 4, pipe4f>(m, v);
+        __m128 r0 = _mm_mul_ps(m.vdata[0].idata, v.idata);
+        __m128 r1 = _mm_mul_ps(m.vdata[1].idata, v.idata);
+        __m128 r2 = _mm_mul_ps(m.vdata[2].idata, v.idata);
+        __m128 r3 = _mm_mul_ps(m.vdata[3].idata, v.idata);
+        // Lane i of the sum is then the dot product of row i.
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        return _mm_add_ps(_mm_add_ps(r0, r1), _mm_add_ps(r2, r3));
+    }
+    // v * m, v as a row.
+    [[nodiscard]] constexpr Vec4f operator*(const Vec4f& v, const Mat4f& m) {
+        if (std::is_constant_evaluated()) return operator*<float32_t, 4, 4, pipe4f>(v, m);
+        return Mat4f_row(v.idata, m);
+    }
+    [[nodiscard]] constexpr Mat4f transpose(const Mat4f& m) {
+        if (std::is_constant_evaluated()) return transpose<float32_t, 4, 4, pipe4f>(m);
+        __m128 r0 = m.vdata[0].idata, r1 = m.vdata[1].idata, r2 = m.vdata[2].idata, r3 = m.vdata[3].idata;
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        return Mat4f_make(r0, r1, r2, r3);
+    }
+
+    ///////////////////////////////////////////////////////////
+    // Inverse and determinant.
+    // The 4 x 4 ones split m into 2 x 2 blocks a b / c d, each block one
+    // register (m00, m01, m10, m11), and invert blockwise with adjugates
+    // (x# below), so no lane ever needs a scalar division but one.
+    ///////////////////////////////////////////////////////////
+    template <std::size_t I0, std::size_t I1, std::size_t I2, std::size_t I3>
+    inline __m128 Mat4f_swz(__m128 v) { return _mm_shuffle_ps(v, v, (Swizzle_imm<I0, I1, I2, I3>)); }
+    // 2 x 2 products a * b, a# * b and a * b#.
+    inline __m128 Mat2f_mul(__m128 a, __m128 b) {
+        return _mm_add_ps(_mm_mul_ps(a, Mat4f_swz<0, 3, 0, 3>(b)), _mm_mul_ps(Mat4f_swz<1, 0, 3, 2>(a), Mat4f_swz<2, 1, 2, 1>(b)));
+    }
+    inline __m128 Mat2f_adj_mul(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(Mat4f_swz<3, 3, 0, 0>(a), b), _mm_mul_ps(Mat4f_swz<1, 1, 2, 2>(a), Mat4f_swz<2, 3, 0, 1>(b)));
+    }
+    inline __m128 Mat2f_mul_adj(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(a, Mat4f_swz<3, 0, 3, 0>(b)), _mm_mul_ps(Mat4f_swz<1, 0, 3, 2>(a), Mat4f_swz<2, 1, 2, 1>(b)));
+    }
+    struct Mat4f_blocks {
+        __m128 a, b, c, d;
+        __m128 det;     // |a| |b| |c| |d|
+        __m128 ab, dc;  // a# * b and d# * c
+    };
+    inline Mat4f_blocks Mat4f_split(const Mat4f& m) {
+        const __m128 r0 = m.vdata[0].idata, r1 = m.vdata[1].idata, r2 = m.vdata[2].idata, r3 = m.vdata[3].idata;
+        Mat4f_blocks s;
+        s.a   = _mm_movelh_ps(r0, r1);
+        s.b   = _mm_movehl_ps(r1, r0);
+        s.c   = _mm_movelh_ps(r2, r3);
+        s.d   = _mm_movehl_ps(r3, r2);
+        s.det = _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(r0, r2, (Swizzle_imm<0, 2, 0, 2>)), _mm_shuffle_ps(r1, r3, (Swizzle_imm<1, 3, 1, 3>))),
+                           _mm_mul_ps(_mm_shuffle_ps(r0, r2, (Swizzle_imm<1, 3, 1, 3>)), _mm_shuffle_ps(r1, r3, (Swizzle_imm<0, 2, 0, 2>))));
+        s.ab  = Mat2f_adj_mul(s.a, s.b);
+        s.dc  = Mat2f_adj_mul(s.d, s.c);
+        return s;
+    }
+    // |m| = |a||d| + |b||c| - tr(a#b d#c), in every lane.
+    inline __m128 Mat4f_det(const Mat4f_blocks& s) {
+        __m128 tr = _mm_mul_ps(s.ab, Mat4f_swz<0, 2, 1, 3>(s.dc));
+        tr = _mm_add_ps(tr, Mat4f_swz<2, 3, 0, 1>(tr));
+        tr = _mm_add_ps(tr, Mat4f_swz<1, 0, 3, 2>(tr));
+        const __m128 ad = _mm_mul_ps(Mat4f_swz<0, 0, 0, 0>(s.det), Mat4f_swz<3, 3, 3, 3>(s.det));
+        const __m128 bc = _mm_mul_ps(Mat4f_swz<1, 1, 1, 1>(s.det), Mat4f_swz<2, 2, 2, 2>(s.det));
+        return _mm_sub_ps(_mm_add_ps(ad, bc), tr);
+    }
+    [[nodiscard]] constexpr float32_t determinant(const Mat4f& m) {
+        if (std::is_constant_evaluated()) return determinant<float32_t, 4, pipe4f>(m);
+        return _mm_cvtss_f32(Mat4f_det(Mat4f_split(m)));
+    }
+    // Singular matrices give inf or nan, like the generic one.
+    [[nodiscard]] constexpr Mat4f inverse(const Mat4f& m) {
+        if (std::is_constant_evaluated()) return inverse<float32_t, 4, pipe4f>(m);
+        const Mat4f_blocks s = Mat4f_split(m);
+        // m^-1 = 1 / |m| * (x y / z w), each of those built as its adjugate.
+        __m128 x = _mm_sub_ps(_mm_mul_ps(Mat4f_swz<3, 3, 3, 3>(s.det), s.a), Mat2f_mul(s.b, s.dc));
+        __m128 w = _mm_sub_ps(_mm_mul_ps(Mat4f_swz<0, 0, 0, 0>(s.det), s.d), Mat2f_mul(s.c, s.ab));
+        __m128 y = _mm_sub_ps(_mm_mul_ps(Mat4f_swz<1, 1, 1, 1>(s.det), s.c), Mat2f_mul_adj(s.d, s.ab));
+        __m128 z = _mm_sub_ps(_mm_mul_ps(Mat4f_swz<2, 2, 2, 2>(s.det), s.b), Mat2f_mul_adj(s.a, s.dc));
+        // Adjugate signs folded into the reciprocal.
+        const __m128 k = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), Mat4f_det(s));
+        x = _mm_mul_ps(x, k); y = _mm_mul_ps(y, k); z = _mm_mul_ps(z, k); w = _mm_mul_ps(w, k);
+        return Mat4f_make(
+            _mm_shuffle_ps(x, y, (Swizzle_imm<3, 1, 3, 1>)),
+            _mm_shuffle_ps(x, y, (Swizzle_imm<2, 0, 2, 0>)),
+            _mm_shuffle_ps(z, w, (Swizzle_imm<3, 1, 3, 1>)),
+            _mm_shuffle_ps(z, w, (Swizzle_imm<2, 0, 2, 0>)));
+    }
+    // Columns of the linear part scaled by their inverse squared length are
+    // the rows of its inverse, see the generic affine_inverse.
+    [[nodiscard]] constexpr Mat4f affine_inverse(const Mat4f& m) {
+        if (std::is_constant_evaluated()) return affine_inverse<float32_t, 4, pipe4f>(m);
+        __m128 r0 = m.vdata[0].idata, r1 = m.vdata[1].idata, r2 = m.vdata[2].idata;
+        // Lane i is the squared length of column i, lane 3 is left over.
+        const __m128 k = _mm_div_ps(_mm_set1_ps(1.f), _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_mul_ps(r2, r2)));
+        const __m128 t0 = Mat4f_swz<3, 3, 3, 3>(r0), t1 = Mat4f_swz<3, 3, 3, 3>(r1), t2 = Mat4f_swz<3, 3, 3, 3>(r2);
+        r0 = _mm_mul_ps(r0, k); r1 = _mm_mul_ps(r1, k); r2 = _mm_mul_ps(r2, k);
+        // Columns of the new linear part, so the new translation is minus their sum weighted by t.
+        __m128 r3 = _mm_sub_ps(_mm_setzero_ps(), Mat4f_madd(r0, t0, Mat4f_madd(r1, t1, _mm_mul_ps(r2, t2))));
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        return Mat4f_make(r0, r1, r2, _mm_setr_ps(0.f, 0.f, 0.f, 1.f));
+    }
+
+    // mat3x3f rows are three packed floats. The last row is loaded from one
+    // float earlier and shifted down so no load leaves the matrix. Lane 3 of
+    // every row then holds some other element of m, so it stays finite.
+    inline void Mat3f_load(const Mat3f& m, __m128& r0, __m128& r1, __m128& r2) {
+        r0 = _mm_loadu_ps(m.adata);
+        r1 = _mm_loadu_ps(m.adata + 3);
+        r2 = Mat4f_swz<1, 2, 3, 3>(_mm_loadu_ps(m.adata + 5));
+    }
+    // a x b in lanes 0 to 2, zero in lane 3.
+    inline __m128 Mat3f_cross(__m128 a, __m128 b) {
+        return _mm_sub_ps(_mm_mul_ps(Mat4f_swz<1, 2, 0, 3>(a), Mat4f_swz<2, 0, 1, 3>(b)),
+                          _mm_mul_ps(Mat4f_swz<2, 0, 1, 3>(a), Mat4f_swz<1, 2, 0, 3>(b)));
+    }
+    [[nodiscard]] constexpr float32_t determinant(const Mat3f& m) {
+        if (std::is_constant_evaluated()) return determinant<float32_t, 3, pipe4f>(m);
+        __m128 r0, r1, r2;
+        Mat3f_load(m, r0, r1, r2);
+        return _mm_cvtss_f32(Vec4f_dot(r0, Mat3f_cross(r1, r2)));
+    }
+    // Column i of the inverse is the cross product of the two other rows over |m|.
+    [[nodiscard]] constexpr Mat3f inverse(const Mat3f& m) {
+        if (std::is_constant_evaluated()) return inverse<float32_t, 3, pipe4f>(m);
+        __m128 r0, r1, r2;
+        Mat3f_load(m, r0, r1, r2);
+        __m128 c0 = Mat3f_cross(r1, r2), c1 = Mat3f_cross(r2, r0), c2 = Mat3f_cross(r0, r1), c3 = _mm_setzero_ps();
+        const __m128 k = _mm_div_ps(_mm_set1_ps(1.f), Vec4f_dot(r0, c0));
+        _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+        Mat3f target{};
+        // Front to back, every store overwrites the spare lane of the one before.
+        _mm_storeu_ps(target.adata, _mm_mul_ps(c0, k));
+        _mm_storeu_ps(target.adata + 3, _mm_mul_ps(c1, k));
+        c2 = _mm_mul_ps(c2, k);
+        _mm_storel_pi(reinterpret_cast<__m64*>(target.adata + 6), c2);
+        _mm_store_ss(target.adata + 8, _mm_movehl_ps(c2, c2));
+        return target;
+    }
+}
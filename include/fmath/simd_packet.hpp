@@ -0,0 +1,273 @@
+#pragma once
+#include <algorithm>
+#include <span>
+#include "basic_vector.hpp"
+#include "simd_primary.hpp"
+#include "simd_vec4f.hpp"
+
+#if FMA_ARCH & FMA_ARCH_X86
+namespace force::math {
+    // Packet of lane::size vectors, one register per component (x0..x3 | y0..y3 | z0..z3),
+    // so every operation below works on all the vectors of the packet at once.
+    // Meant for ray and particle packets, SIMDVector4 is a single xyzw vector instead.
+    // Width is 4 (__m128, vec3x4), 8 with AVX2 (__m256, vec3x8) or 16 with AVX-512
+    // (__m512, vec3x16), the register type itself isn't a template argument (see lane_of).
+    // Per vector results (dot, length) are a register, one value per lane.
+    template <std::size_t Width, std::size_t Dimension>
+    class basic_packet {
+    public:
+        using lane_type     = simd::lane_of<Width * 32>;
+        using register_type = typename lane_type::type;
+        using value_type    = float32_t;
+
+        register_type pdata[Dimension];
+
+        static constexpr std::size_t dimension = Dimension;
+        static constexpr std::size_t width     = Width;
+
+        basic_packet() { std::fill(pdata, pdata + dimension, lane_type::set1(0.f)); }
+        // Every lane set to v.
+        template <class VecPipeT>
+        explicit basic_packet(const basic_vector<float32_t, Dimension, VecPipeT>& v) {
+            for (std::size_t k = 0; k < dimension; ++k) pdata[k] = lane_type::set1(v[k]);
+        }
+
+        // width vectors from an array of vec3f/vec4f, transposed into the registers.
+        template <class VecPipeT>
+        static basic_packet load(const basic_vector<float32_t, Dimension, VecPipeT>* v) {
+            static_assert(sizeof(*v) == Dimension * sizeof(float32_t), "Vectors must be tightly packed!");
+            basic_packet p;
+            Packet_load(reinterpret_cast<const float32_t*>(v), p.pdata);
+            return p;
+        }
+        // Up to width vectors, missing lanes are zero.
+        template <class VecPipeT>
+        static basic_packet load(std::span<const basic_vector<float32_t, Dimension, VecPipeT>> v) {
+            if (v.size() >= width) return load(v.data());
+            basic_vector<float32_t, Dimension, VecPipeT> tail[width];
+            std::copy(v.begin(), v.end(), tail);
+            return load(tail);
+        }
+        // And back, the lanes written out as width vectors.
+        template <class VecPipeT>
+        void store(basic_vector<float32_t, Dimension, VecPipeT>* v) const {
+            static_assert(sizeof(*v) == Dimension * sizeof(float32_t), "Vectors must be tightly packed!");
+            Packet_store(pdata, reinterpret_cast<float32_t*>(v));
+        }
+        // Only the first min(v.size(), width) lanes.
+        template <class VecPipeT>
+        void store(std::span<basic_vector<float32_t, Dimension, VecPipeT>> v) const {
+            if (v.size() >= width) return store(v.data());
+            basic_vector<float32_t, Dimension, VecPipeT> tail[width];
+            store(tail);
+            std::copy(tail, tail + v.size(), v.begin());
+        }
+
+        // Vector i of the packet.
+        basic_vector<float32_t, Dimension, pipe4f> get(std::size_t i) const {
+            basic_vector<float32_t, Dimension, pipe4f> v;
+            for (std::size_t k = 0; k < dimension; ++k) v[k] = reinterpret_cast<const float32_t*>(&pdata[k])[i];
+            return v;
+        }
+        template <class VecPipeT>
+        void set(std::size_t i, const basic_vector<float32_t, Dimension, VecPipeT>& v) {
+            for (std::size_t k = 0; k < dimension; ++k) reinterpret_cast<float32_t*>(&pdata[k])[i] = v[k];
+        }
+
+        basic_packet& operator+=(const basic_packet& right) {
+            for (std::size_t k = 0; k < dimension; ++k) pdata[k] = simd::Intrin_add(pdata[k], right.pdata[k]);
+            return *this;
+        }
+        basic_packet& operator-=(const basic_packet& right) {
+            for (std::size_t k = 0; k < dimension; ++k) pdata[k] = simd::Intrin_sub(pdata[k], right.pdata[k]);
+            return *this;
+        }
+        // One factor per lane.
+        basic_packet& operator*=(register_type k) {
+            for (std::size_t i = 0; i < dimension; ++i) pdata[i] = simd::Intrin_mul(pdata[i], k);
+            return *this;
+        }
+        basic_packet& operator/=(register_type k) {
+            for (std::size_t i = 0; i < dimension; ++i) pdata[i] = simd::Intrin_div(pdata[i], k);
+            return *this;
+        }
+        basic_packet& operator*=(float32_t k) { return *this *= lane_type::set1(k); }
+        basic_packet& operator/=(float32_t k) { return *this /= lane_type::set1(k); }
+        register_type&       operator[](std::size_t k)       { return pdata[k]; }
+        const register_type& operator[](std::size_t k) const { return pdata[k]; }
+
+        register_type&       x()       { return pdata[0]; }
+        const register_type& x() const { return pdata[0]; }
+        register_type&       y()       { return pdata[1]; }
+        const register_type& y() const { return pdata[1]; }
+        register_type&       z()       requires (Dimension > 2) { return pdata[2]; }
+        const register_type& z() const requires (Dimension > 2) { return pdata[2]; }
+        register_type&       w()       requires (Dimension > 3) { return pdata[3]; }
+        const register_type& w() const requires (Dimension > 3) { return pdata[3]; }
+
+    private:
+        // 4 vectors of 2 to 4 floats <-> 4 registers, shuffles only.
+        static void Packet_load4(const float32_t* f, __m128* r) {
+            if constexpr (Dimension == 4) {
+                __m128 a = _mm_loadu_ps(f), b = _mm_loadu_ps(f + 4), c = _mm_loadu_ps(f + 8), d = _mm_loadu_ps(f + 12);
+                _MM_TRANSPOSE4_PS(a, b, c, d);
+                r[0] = a; r[1] = b; r[2] = c; r[3] = d;
+            }
+            else if constexpr (Dimension == 3) {
+                // x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3
+                __m128 a = _mm_loadu_ps(f), b = _mm_loadu_ps(f + 4), c = _mm_loadu_ps(f + 8);
+                r[0] = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, (Swizzle_imm<2, 2, 1, 1>)), (Swizzle_imm<0, 3, 0, 2>));
+                r[1] = _mm_shuffle_ps(_mm_shuffle_ps(a, b, (Swizzle_imm<1, 1, 0, 0>)), _mm_shuffle_ps(b, c, (Swizzle_imm<3, 3, 2, 2>)), (Swizzle_imm<0, 2, 0, 2>));
+                r[2] = _mm_shuffle_ps(_mm_shuffle_ps(a, b, (Swizzle_imm<2, 2, 1, 1>)), c, (Swizzle_imm<0, 2, 0, 3>));
+            }
+            else {
+                __m128 a = _mm_loadu_ps(f), b = _mm_loadu_ps(f + 4);
+                r[0] = _mm_shuffle_ps(a, b, (Swizzle_imm<0, 2, 0, 2>));
+                r[1] = _mm_shuffle_ps(a, b, (Swizzle_imm<1, 3, 1, 3>));
+            }
+        }
+        static void Packet_store4(const __m128* r, float32_t* f) {
+            if constexpr (Dimension == 4) {
+                __m128 a = r[0], b = r[1], c = r[2], d = r[3];
+                _MM_TRANSPOSE4_PS(a, b, c, d);
+                _mm_storeu_ps(f, a); _mm_storeu_ps(f + 4, b); _mm_storeu_ps(f + 8, c); _mm_storeu_ps(f + 12, d);
+            }
+            else if constexpr (Dimension == 3) {
+                const __m128 x = r[0], y = r[1], z = r[2];
+                _mm_storeu_ps(f,     _mm_shuffle_ps(_mm_unpacklo_ps(x, y), _mm_shuffle_ps(z, x, (Swizzle_imm<0, 0, 1, 1>)), (Swizzle_imm<0, 1, 0, 2>)));
+                _mm_storeu_ps(f + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, (Swizzle_imm<1, 1, 1, 1>)), _mm_shuffle_ps(x, y, (Swizzle_imm<2, 2, 2, 2>)), (Swizzle_imm<0, 2, 0, 2>)));
+                _mm_storeu_ps(f + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, (Swizzle_imm<2, 2, 3, 3>)), _mm_shuffle_ps(y, z, (Swizzle_imm<3, 3, 3, 3>)), (Swizzle_imm<0, 2, 0, 2>)));
+            }
+            else {
+                _mm_storeu_ps(f,     _mm_unpacklo_ps(r[0], r[1]));
+                _mm_storeu_ps(f + 4, _mm_unpackhi_ps(r[0], r[1]));
+            }
+        }
+        static void Packet_load(const float32_t* f, register_type* r) {
+            if constexpr (Dimension < 2 || Dimension > 4) {
+                alignas(64) float32_t t[Dimension][width];
+                for (std::size_t i = 0; i < width; ++i)
+                    for (std::size_t k = 0; k < dimension; ++k) t[k][i] = f[i * dimension + k];
+                for (std::size_t k = 0; k < dimension; ++k) r[k] = lane_type::load(t[k]);
+            }
+            else if constexpr (width == 4) Packet_load4(f, r);
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+            else if constexpr (width == 8) {
+                // Both 4 vector halves, then one insert per component.
+                __m128 lo[Dimension], hi[Dimension];
+                Packet_load4(f, lo);
+                Packet_load4(f + 4 * dimension, hi);
+                for (std::size_t k = 0; k < dimension; ++k) r[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(lo[k]), hi[k], 1);
+            }
+#endif
+            else {
+                for (std::size_t i = 0; i < width / 4; ++i) {
+                    __m128 q[Dimension];
+                    Packet_load4(f + i * 4 * dimension, q);
+                    for (std::size_t k = 0; k < dimension; ++k) reinterpret_cast<__m128*>(&r[k])[i] = q[k];
+                }
+            }
+        }
+        static void Packet_store(const register_type* r, float32_t* f) {
+            if constexpr (Dimension < 2 || Dimension > 4) {
+                alignas(64) float32_t t[Dimension][width];
+                for (std::size_t k = 0; k < dimension; ++k) lane_type::store(t[k], r[k]);
+                for (std::size_t i = 0; i < width; ++i)
+                    for (std::size_t k = 0; k < dimension; ++k) f[i * dimension + k] = t[k][i];
+            }
+            else if constexpr (width == 4) Packet_store4(r, f);
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+            else if constexpr (width == 8) {
+                __m128 lo[Dimension], hi[Dimension];
+                for (std::size_t k = 0; k < dimension; ++k) {
+                    lo[k] = _mm256_castps256_ps128(r[k]);
+                    hi[k] = _mm256_extractf128_ps(r[k], 1);
+                }
+                Packet_store4(lo, f);
+                Packet_store4(hi, f + 4 * dimension);
+            }
+#endif
+            else {
+                for (std::size_t i = 0; i < width / 4; ++i) {
+                    __m128 q[Dimension];
+                    for (std::size_t k = 0; k < dimension; ++k) q[k] = reinterpret_cast<const __m128*>(&r[k])[i];
+                    Packet_store4(q, f + i * 4 * dimension);
+                }
+            }
+        }
+    };
+
+    using vec2x4 = basic_packet<4, 2>;
+    using vec3x4 = basic_packet<4, 3>;
+    using vec4x4 = basic_packet<4, 4>;
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+    using vec2x8 = basic_packet<8, 2>;
+    using vec3x8 = basic_packet<8, 3>;
+    using vec4x8 = basic_packet<8, 4>;
+#endif
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+    using vec2x16 = basic_packet<16, 2>;
+    using vec3x16 = basic_packet<16, 3>;
+    using vec4x16 = basic_packet<16, 4>;
+#endif
+
+    // Register of a Width lane packet, for the per lane factors and results below.
+    template <std::size_t Width>
+    using Packet_reg = typename simd::lane_of<Width * 32>::type;
+
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> operator+(basic_packet<Width, Dimension> a, const basic_packet<Width, Dimension>& b) { return a += b; }
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> operator-(basic_packet<Width, Dimension> a, const basic_packet<Width, Dimension>& b) { return a -= b; }
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> operator*(basic_packet<Width, Dimension> a, Packet_reg<Width> k) { return a *= k; }
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> operator*(Packet_reg<Width> k, basic_packet<Width, Dimension> a) { return a *= k; }
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> operator*(basic_packet<Width, Dimension> a, float32_t k)         { return a *= k; }
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> operator*(float32_t k, basic_packet<Width, Dimension> a)         { return a *= k; }
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> operator/(basic_packet<Width, Dimension> a, Packet_reg<Width> k) { return a /= k; }
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> operator/(basic_packet<Width, Dimension> a, float32_t k)         { return a /= k; }
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> operator-(const basic_packet<Width, Dimension>& a) { return basic_packet<Width, Dimension>() -= a; }
+
+    // Lane i of the result belongs to vector i of the packets.
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] Packet_reg<Width> dot(const basic_packet<Width, Dimension>& a, const basic_packet<Width, Dimension>& b) {
+        Packet_reg<Width> s = simd::Intrin_mul(a[0], b[0]);
+        for (std::size_t k = 1; k < Dimension; ++k) s = simd::Intrin_add(s, simd::Intrin_mul(a[k], b[k]));
+        return s;
+    }
+    // Hardware square root, correctly rounded.
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] Packet_reg<Width> length(const basic_packet<Width, Dimension>& a) {
+        return simd::Intrin_sqrt(dot(a, a));
+    }
+    // Same rsqrt as the scalar norm.
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> norm(const basic_packet<Width, Dimension>& a) {
+        return a * simd::rsqrt(dot(a, a));
+    }
+    template <std::size_t Width>
+    [[nodiscard]] basic_packet<Width, 3> cross(const basic_packet<Width, 3>& a, const basic_packet<Width, 3>& b) {
+        using simd::Intrin_mul, simd::Intrin_sub;
+        basic_packet<Width, 3> r;
+        r[0] = Intrin_sub(Intrin_mul(a[1], b[2]), Intrin_mul(b[1], a[2]));
+        r[1] = Intrin_sub(Intrin_mul(a[2], b[0]), Intrin_mul(b[2], a[0]));
+        r[2] = Intrin_sub(Intrin_mul(a[0], b[1]), Intrin_mul(b[0], a[1]));
+        return r;
+    }
+    // a + (b - a) * t, t per lane or for all.
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> lerp(const basic_packet<Width, Dimension>& a, const basic_packet<Width, Dimension>& b, Packet_reg<Width> t) {
+        return a + (b - a) * t;
+    }
+    template <std::size_t Width, std::size_t Dimension>
+    [[nodiscard]] basic_packet<Width, Dimension> lerp(const basic_packet<Width, Dimension>& a, const basic_packet<Width, Dimension>& b, float32_t t) {
+        return lerp(a, b, simd::lane_of<Width * 32>::set1(t));
+    }
+}
+#endif
@@ -0,0 +1,492 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "constant.hpp"
+#include "simd_decl.hpp"
+
+#if FMA_ARCH & FMA_ARCH_X86
+#include <emmintrin.h>
+#endif
+
+// Lane-wise versions of primary.hpp algorithms.
+// Every kernel is written once against the Intrin_* primitives below and
+// instantiated for each register width, so they run the exact same bit hacks
+// and polynomials as the scalar functions, only 4, 8 or 16 at a time.
+//
+// The same kernels get compiled at several FMA_ARCH levels in one program
+// (see primary_batch_avx2.cpp), each level lives in its own inline namespace
+// so the linker never mixes an avx2 instantiation into the sse2 code.
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+#define FMA_SIMD_ABI avx512
+#elif FMA_ARCH & FMA_ARCH_AVX2_BIT
+#define FMA_SIMD_ABI avx2
+#elif FMA_ARCH & FMA_ARCH_AVX_BIT
+#define FMA_SIMD_ABI avx
+#elif FMA_ARCH & FMA_ARCH_SSE41_BIT
+#define FMA_SIMD_ABI sse41
+#else
+#define FMA_SIMD_ABI sse2
+#endif
+
+namespace force::math::simd {
+inline namespace FMA_SIMD_ABI {
+#if FMA_ARCH & FMA_ARCH_X86
+    // Traits of one float register, keyed on its width in bits. Writing __m128
+    // itself as a template argument makes GCC drop its vector attributes and
+    // warn (-Wignored-attributes) at every use, so code that names a register
+    // type directly goes through lane_of<128>/<256>/<512>.
+    template <std::size_t Bits> struct lane_of;
+    // The traits of a deduced register type, for the kernels below.
+    template <class Fp> using lane = lane_of<sizeof(Fp) * 8>;
+
+    ////////////////////////
+    // SSE2 (4 x float32_t)
+    ////////////////////////
+    template <> struct lane_of<128> {
+        using type     = __m128;
+        using int_type = __m128i;
+        static constexpr std::size_t size = 4;
+
+        static __m128  set1(float32_t v)           { return _mm_set1_ps(v); }
+        static __m128i set1(int32_t v)             { return _mm_set1_epi32(v); }
+        static __m128  load(const float32_t* p)    { return _mm_loadu_ps(p); }
+        static void    store(float32_t* p, __m128 v) { _mm_storeu_ps(p, v); }
+        // Register from size / 4 quarters, lowest first, and back.
+        static __m128  join(const __m128* q)       { return q[0]; }
+        static void    split(__m128 v, __m128* q)  { q[0] = v; }
+    };
+    inline __m128  Intrin_add(__m128 a, __m128 b)     { return _mm_add_ps(a, b); }
+    inline __m128  Intrin_sub(__m128 a, __m128 b)     { return _mm_sub_ps(a, b); }
+    inline __m128  Intrin_mul(__m128 a, __m128 b)     { return _mm_mul_ps(a, b); }
+    inline __m128  Intrin_div(__m128 a, __m128 b)     { return _mm_div_ps(a, b); }
+    // a * b + c, fused where the isa has it. The kernels below keep separate
+    // mul and add to round like the scalar functions, only GEMM uses this.
+    inline __m128  Intrin_fmadd(__m128 a, __m128 b, __m128 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    inline __m128i Intrin_add(__m128i a, __m128i b)   { return _mm_add_epi32(a, b); }
+    inline __m128i Intrin_sub(__m128i a, __m128i b)   { return _mm_sub_epi32(a, b); }
+    inline __m128i Intrin_and(__m128i a, __m128i b)   { return _mm_and_si128(a, b); }
+    inline __m128i Intrin_or (__m128i a, __m128i b)   { return _mm_or_si128(a, b); }
+    inline __m128i Intrin_xor(__m128i a, __m128i b)   { return _mm_xor_si128(a, b); }
+    inline __m128i Intrin_andnot(__m128i a, __m128i b){ return _mm_andnot_si128(a, b); }
+    inline __m128i Intrin_cmpeq(__m128i a, __m128i b) { return _mm_cmpeq_epi32(a, b); }
+    inline __m128i Intrin_cmpeq(__m128 a, __m128 b)   { return _mm_castps_si128(_mm_cmpeq_ps(a, b)); }
+    inline __m128i Intrin_cmpgt(__m128 a, __m128 b)   { return _mm_castps_si128(_mm_cmpgt_ps(a, b)); }
+    inline __m128  Intrin_sqrt(__m128 a)              { return _mm_sqrt_ps(a); }
+    // Picks a where mask lanes are all ones and b elsewhere.
+    inline __m128i Intrin_select(__m128i m, __m128i a, __m128i b) {
+#if FMA_ARCH & FMA_ARCH_SSE41_BIT
+        return _mm_blendv_epi8(b, a, m);
+#else
+        return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+#endif
+    }
+    inline __m128  Intrin_select(__m128i m, __m128 a, __m128 b) {
+        return _mm_castsi128_ps(Intrin_select(m, _mm_castps_si128(a), _mm_castps_si128(b)));
+    }
+    template <int N> __m128i Intrin_sll(__m128i a)    { return _mm_slli_epi32(a, N); }
+    template <int N> __m128i Intrin_srl(__m128i a)    { return _mm_srli_epi32(a, N); }
+    template <int N> __m128i Intrin_sra(__m128i a)    { return _mm_srai_epi32(a, N); }
+    // Bit casts (bit_cast<int32_t> and bit_cast<float32_t> in scalar code).
+    inline __m128i Intrin_bits (__m128 a)             { return _mm_castps_si128(a); }
+    inline __m128  Intrin_float(__m128i a)            { return _mm_castsi128_ps(a); }
+    // Value conversions ((int32_t)f and (float32_t)i in scalar code).
+    inline __m128i Intrin_cvtt(__m128 a)              { return _mm_cvttps_epi32(a); }
+    inline __m128  Intrin_cvt (__m128i a)             { return _mm_cvtepi32_ps(a); }
+    // Exact i / 3 for non-negative i, multiply-high by 0xaaaa'aaab then shift.
+    inline __m128i Intrin_div3(__m128i a) {
+        const __m128i m = _mm_set1_epi32(static_cast<int32_t>(0xaaaa'aaab));
+        __m128i ev = _mm_srli_epi64(_mm_mul_epu32(a, m), 33);
+        __m128i od = _mm_srli_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), m), 33);
+        return _mm_or_si128(ev, _mm_slli_epi64(od, 32));
+    }
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+    ////////////////////////
+    // AVX2 (8 x float32_t)
+    ////////////////////////
+    template <> struct lane_of<256> {
+        using type     = __m256;
+        using int_type = __m256i;
+        static constexpr std::size_t size = 8;
+
+        static __m256  set1(float32_t v)           { return _mm256_set1_ps(v); }
+        static __m256i set1(int32_t v)             { return _mm256_set1_epi32(v); }
+        static __m256  load(const float32_t* p)    { return _mm256_loadu_ps(p); }
+        static void    store(float32_t* p, __m256 v) { _mm256_storeu_ps(p, v); }
+        static __m256  join(const __m128* q)       { return _mm256_insertf128_ps(_mm256_castps128_ps256(q[0]), q[1], 1); }
+        static void    split(__m256 v, __m128* q)  { q[0] = _mm256_castps256_ps128(v); q[1] = _mm256_extractf128_ps(v, 1); }
+    };
+    inline __m256  Intrin_add(__m256 a, __m256 b)     { return _mm256_add_ps(a, b); }
+    inline __m256  Intrin_sub(__m256 a, __m256 b)     { return _mm256_sub_ps(a, b); }
+    inline __m256  Intrin_mul(__m256 a, __m256 b)     { return _mm256_mul_ps(a, b); }
+    inline __m256  Intrin_div(__m256 a, __m256 b)     { return _mm256_div_ps(a, b); }
+#if defined(__FMA__) || (FMA_COMPILER & FMA_COMPILER_VC)
+    inline __m256  Intrin_fmadd(__m256 a, __m256 b, __m256 c) { return _mm256_fmadd_ps(a, b, c); }
+#else
+    inline __m256  Intrin_fmadd(__m256 a, __m256 b, __m256 c) { return _mm256_add_ps(_mm256_mul_ps(a, b), c); }
+#endif
+    inline __m256i Intrin_add(__m256i a, __m256i b)   { return _mm256_add_epi32(a, b); }
+    inline __m256i Intrin_sub(__m256i a, __m256i b)   { return _mm256_sub_epi32(a, b); }
+    inline __m256i Intrin_and(__m256i a, __m256i b)   { return _mm256_and_si256(a, b); }
+    inline __m256i Intrin_or (__m256i a, __m256i b)   { return _mm256_or_si256(a, b); }
+    inline __m256i Intrin_xor(__m256i a, __m256i b)   { return _mm256_xor_si256(a, b); }
+    inline __m256i Intrin_andnot(__m256i a, __m256i b){ return _mm256_andnot_si256(a, b); }
+    inline __m256i Intrin_cmpeq(__m256i a, __m256i b) { return _mm256_cmpeq_epi32(a, b); }
+    inline __m256i Intrin_cmpeq(__m256 a, __m256 b)   { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    inline __m256i Intrin_cmpgt(__m256 a, __m256 b)   { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_GT_OQ)); }
+    inline __m256  Intrin_sqrt(__m256 a)              { return _mm256_sqrt_ps(a); }
+    inline __m256i Intrin_select(__m256i m, __m256i a, __m256i b) { return _mm256_blendv_epi8(b, a, m); }
+    inline __m256  Intrin_select(__m256i m, __m256 a, __m256 b)   { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(m)); }
+    template <int N> __m256i Intrin_sll(__m256i a)    { return _mm256_slli_epi32(a, N); }
+    template <int N> __m256i Intrin_srl(__m256i a)    { return _mm256_srli_epi32(a, N); }
+    template <int N> __m256i Intrin_sra(__m256i a)    { return _mm256_srai_epi32(a, N); }
+    inline __m256i Intrin_bits (__m256 a)             { return _mm256_castps_si256(a); }
+    inline __m256  Intrin_float(__m256i a)            { return _mm256_castsi256_ps(a); }
+    inline __m256i Intrin_cvtt(__m256 a)              { return _mm256_cvttps_epi32(a); }
+    inline __m256  Intrin_cvt (__m256i a)             { return _mm256_cvtepi32_ps(a); }
+    inline __m256i Intrin_div3(__m256i a) {
+        const __m256i m = _mm256_set1_epi32(static_cast<int32_t>(0xaaaa'aaab));
+        __m256i ev = _mm256_srli_epi64(_mm256_mul_epu32(a, m), 33);
+        __m256i od = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), m), 33);
+        return _mm256_or_si256(ev, _mm256_slli_epi64(od, 32));
+    }
+#endif
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+    ////////////////////////////
+    // AVX-512F (16 x float32_t)
+    ////////////////////////////
+    template <> struct lane_of<512> {
+        using type     = __m512;
+        using int_type = __m512i;
+        static constexpr std::size_t size = 16;
+
+        static __m512  set1(float32_t v)           { return _mm512_set1_ps(v); }
+        static __m512i set1(int32_t v)             { return _mm512_set1_epi32(v); }
+        static __m512  load(const float32_t* p)    { return _mm512_loadu_ps(p); }
+        static void    store(float32_t* p, __m512 v) { _mm512_storeu_ps(p, v); }
+        static __m512  join(const __m128* q) {
+            const __m512 lo = _mm512_insertf32x4(_mm512_castps128_ps512(q[0]), q[1], 1);
+            return _mm512_insertf32x4(_mm512_insertf32x4(lo, q[2], 2), q[3], 3);
+        }
+        static void    split(__m512 v, __m128* q) {
+            q[0] = _mm512_castps512_ps128(v);        q[1] = _mm512_extractf32x4_ps(v, 1);
+            q[2] = _mm512_extractf32x4_ps(v, 2);     q[3] = _mm512_extractf32x4_ps(v, 3);
+        }
+    };
+    inline __m512  Intrin_add(__m512 a, __m512 b)     { return _mm512_add_ps(a, b); }
+    inline __m512  Intrin_sub(__m512 a, __m512 b)     { return _mm512_sub_ps(a, b); }
+    inline __m512  Intrin_mul(__m512 a, __m512 b)     { return _mm512_mul_ps(a, b); }
+    inline __m512  Intrin_div(__m512 a, __m512 b)     { return _mm512_div_ps(a, b); }
+    inline __m512  Intrin_fmadd(__m512 a, __m512 b, __m512 c) { return _mm512_fmadd_ps(a, b, c); }
+    inline __m512i Intrin_add(__m512i a, __m512i b)   { return _mm512_add_epi32(a, b); }
+    inline __m512i Intrin_sub(__m512i a, __m512i b)   { return _mm512_sub_epi32(a, b); }
+    inline __m512i Intrin_and(__m512i a, __m512i b)   { return _mm512_and_si512(a, b); }
+    inline __m512i Intrin_or (__m512i a, __m512i b)   { return _mm512_or_si512(a, b); }
+    inline __m512i Intrin_xor(__m512i a, __m512i b)   { return _mm512_xor_si512(a, b); }
+    inline __m512i Intrin_andnot(__m512i a, __m512i b){ return _mm512_andnot_si512(a, b); }
+    // Compares give a k-register, widen it back to a lane mask for Intrin_select.
+    inline __m512i Intrin_cmpeq(__m512i a, __m512i b) { return _mm512_maskz_mov_epi32(_mm512_cmpeq_epi32_mask(a, b), _mm512_set1_epi32(-1)); }
+    inline __m512i Intrin_cmpeq(__m512 a, __m512 b)   { return _mm512_maskz_mov_epi32(_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ), _mm512_set1_epi32(-1)); }
+    inline __m512i Intrin_cmpgt(__m512 a, __m512 b)   { return _mm512_maskz_mov_epi32(_mm512_cmp_ps_mask(a, b, _CMP_GT_OQ), _mm512_set1_epi32(-1)); }
+    inline __m512  Intrin_sqrt(__m512 a)              { return _mm512_sqrt_ps(a); }
+    // Bitwise m ? a : b in one ternary logic op.
+    inline __m512i Intrin_select(__m512i m, __m512i a, __m512i b) { return _mm512_ternarylogic_epi32(m, a, b, 0xca); }
+    inline __m512  Intrin_select(__m512i m, __m512 a, __m512 b) {
+        return _mm512_castsi512_ps(Intrin_select(m, _mm512_castps_si512(a), _mm512_castps_si512(b)));
+    }
+    template <int N> __m512i Intrin_sll(__m512i a)    { return _mm512_slli_epi32(a, N); }
+    template <int N> __m512i Intrin_srl(__m512i a)    { return _mm512_srli_epi32(a, N); }
+    template <int N> __m512i Intrin_sra(__m512i a)    { return _mm512_srai_epi32(a, N); }
+    inline __m512i Intrin_bits (__m512 a)             { return _mm512_castps_si512(a); }
+    inline __m512  Intrin_float(__m512i a)            { return _mm512_castsi512_ps(a); }
+    inline __m512i Intrin_cvtt(__m512 a)              { return _mm512_cvttps_epi32(a); }
+    inline __m512  Intrin_cvt (__m512i a)             { return _mm512_cvtepi32_ps(a); }
+    inline __m512i Intrin_div3(__m512i a) {
+        const __m512i m = _mm512_set1_epi32(static_cast<int32_t>(0xaaaa'aaab));
+        __m512i ev = _mm512_srli_epi64(_mm512_mul_epu32(a, m), 33);
+        __m512i od = _mm512_srli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), m), 33);
+        return _mm512_or_si512(ev, _mm512_slli_epi64(od, 32));
+    }
+#endif
+
+    /////////////////////////////////////////////
+    // Kernels, one to one with primary.hpp.
+    /////////////////////////////////////////////
+    template <class Fp> Fp abs(Fp x) {
+        using L = lane<Fp>;
+        return Intrin_float(Intrin_and(Intrin_bits(x), L::set1(0x7fff'ffff)));
+    }
+    // Toward zero. From 2^23 up every float is whole already (and too big for cvtt), NaN passes through.
+    // cvtt loses the sign of -0.3, it is put back so the result is -0 like std::trunc.
+    template <class Fp> Fp Trunc(Fp x) {
+        using L = lane<Fp>;
+        auto small = Intrin_cmpgt(L::set1(0x1p23f), abs(x));
+        auto sign  = Intrin_and(Intrin_bits(x), L::set1(static_cast<int32_t>(0x8000'0000)));
+        return Intrin_float(Intrin_or(Intrin_bits(Intrin_select(small, Intrin_cvt(Intrin_cvtt(x)), x)), sign));
+    }
+    // Lane results stay float, unlike the int32_t of the scalar versions.
+    template <class Fp> Fp floor(Fp x) {
+        using L = lane<Fp>;
+        Fp t = Trunc(x);
+        return Intrin_sub(t, Intrin_float(Intrin_and(Intrin_cmpgt(t, x), Intrin_bits(L::set1(1.f)))));
+    }
+    // Half away from zero. x - Trunc(x) is exact, so there is no x + 0.5 rounding up 0.49999997.
+    // -0 + 0 is +0, the sign is put back so round(-0.3) is -0 like std::round.
+    template <class Fp> Fp round(Fp x) {
+        using L = lane<Fp>;
+        Fp   t = Trunc(x);
+        auto sign  = Intrin_and(Intrin_bits(x), L::set1(static_cast<int32_t>(0x8000'0000)));
+        auto below = Intrin_cmpgt(L::set1(0.5f), abs(Intrin_sub(x, t)));
+        Fp   r = Intrin_add(t, Intrin_float(Intrin_andnot(below, Intrin_or(sign, L::set1(0x3f80'0000)))));
+        return Intrin_float(Intrin_or(Intrin_bits(r), sign));
+    }
+    template <class Fp> Fp sqrt(Fp x) {
+        using L = lane<Fp>;
+        Fp n = Intrin_mul(L::set1(0.5f), x);
+        Fp y = Intrin_float(Intrin_add(L::set1(0x1fbd'1df5), Intrin_sra<1>(Intrin_bits(x))));
+        y = Intrin_add(Intrin_mul(L::set1(0.5f), y), Intrin_div(n, y));
+        y = Intrin_add(Intrin_mul(L::set1(0.5f), y), Intrin_div(n, y));
+        return y;
+    }
+    template <class Fp> Fp rsqrt(Fp x) {
+        using L = lane<Fp>;
+        Fp n = Intrin_mul(L::set1(0.5f), x);
+        Fp y = Intrin_float(Intrin_sub(L::set1(0x5f37'5a86), Intrin_sra<1>(Intrin_bits(x))));
+        y = Intrin_mul(y, Intrin_sub(L::set1(1.5f), Intrin_mul(Intrin_mul(n, y), y)));
+        y = Intrin_mul(y, Intrin_sub(L::set1(1.5f), Intrin_mul(Intrin_mul(n, y), y)));
+        return y;
+    }
+    template <class Fp> Fp cbrt(Fp x) {
+        using L = lane<Fp>;
+        auto h  = Intrin_bits(x);
+        Fp   s  = Intrin_float(Intrin_or(Intrin_and(h, L::set1(static_cast<int32_t>(0x8000'0000))), L::set1(0x3f80'0000)));
+        auto i  = Intrin_and(h, L::set1(0x7fff'ffff));
+        Fp   n  = Intrin_mul(L::set1(0.333333f), Intrin_float(i));
+        Fp   y  = Intrin_float(Intrin_add(L::set1(0x2a2e'5c2f), Intrin_div3(i)));
+        Fp   c  = L::set1(0.666666f);
+        Fp   o  = L::set1(1.f);
+        y = Intrin_add(Intrin_mul(c, y), Intrin_mul(n, Intrin_div(o, Intrin_mul(y, y))));
+        y = Intrin_add(Intrin_mul(c, y), Intrin_mul(n, Intrin_div(o, Intrin_mul(y, y))));
+        y = Intrin_add(Intrin_mul(c, y), Intrin_mul(n, Intrin_div(o, Intrin_mul(y, y))));
+        return Intrin_mul(s, y);
+    }
+    template <class Fp> Fp log(Fp x) {
+        using L = lane<Fp>;
+        auto i  = Intrin_bits(x);
+        auto e  = Intrin_sub(Intrin_sra<23>(i), L::set1(0x7f));
+        Fp   m  = Intrin_float(Intrin_or(Intrin_and(i, L::set1(0x007f'ffff)), L::set1(0x3f80'0000)));
+        Fp   o  = L::set1(1.f);
+        Fp   t  = Intrin_div(Intrin_sub(m, o), Intrin_add(m, o));
+        Fp   t2 = Intrin_mul(t, t);
+        Fp   p  = Intrin_add(L::set1(0.111111f), Intrin_mul(t2, L::set1(0.090909f)));
+        p = Intrin_add(L::set1(0.142857f), Intrin_mul(t2, p));
+        p = Intrin_add(L::set1(0.2f),      Intrin_mul(t2, p));
+        p = Intrin_add(L::set1(0.333333f), Intrin_mul(t2, p));
+        Fp   y  = Intrin_mul(L::set1(2.f), Intrin_add(t, Intrin_mul(Intrin_mul(t2, t), p)));
+        return Intrin_add(Intrin_mul(L::set1(0.693'1471'8055'9945'3094'1723f), Intrin_cvt(e)), y);
+    }
+    template <class Fp> Fp exp(Fp x) {
+        using L = lane<Fp>;
+        Fp   ln2 = L::set1(0.6'9314'7182'4645'9960'9375f);
+        Fp   t = Intrin_div(x, ln2);
+        auto i = Intrin_cvtt(t);
+        Fp   f = Intrin_sub(t, Intrin_cvt(i));
+        Fp   a = Intrin_float(Intrin_sll<23>(Intrin_add(i, L::set1(0x7f))));
+        Fp   b = Intrin_mul(ln2, f);
+        Fp   y = Intrin_add(L::set1(0.0083333f), Intrin_mul(b, L::set1(0.0013888f)));
+        y = Intrin_add(L::set1(0.0416666f), Intrin_mul(b, y));
+        y = Intrin_add(L::set1(0.166666f),  Intrin_mul(b, y));
+        y = Intrin_add(L::set1(0.5f),       Intrin_mul(b, y));
+        y = Intrin_add(L::set1(1.f),        Intrin_mul(b, y));
+        y = Intrin_add(L::set1(1.f),        Intrin_mul(b, y));
+        return Intrin_mul(a, y);
+    }
+    template <class Fp> Fp pow(Fp x, Fp n) {
+        return exp(Intrin_mul(n, log(x)));
+    }
+    template <class Fp> Fp sin(Fp x) {
+        using L = lane<Fp>;
+        Fp   hp = L::set1(halfpi<float32_t>);
+        auto i  = Intrin_bits(x);
+        Fp   s  = Intrin_float(Intrin_or(Intrin_and(i, L::set1(static_cast<int32_t>(0x8000'0000))), L::set1(0x3f80'0000)));
+        Fp   k  = Intrin_float(Intrin_and(i, L::set1(0x7fff'ffff)));
+        Fp   f  = Intrin_div(k, hp);
+        auto q  = Intrin_cvtt(f);
+        Fp   r  = Intrin_mul(Intrin_sub(f, Intrin_cvt(q)), hp);
+        auto d  = Intrin_and(q, L::set1(3));
+        Fp   a  = Intrin_sub(L::set1(1.5f), Intrin_cvt(d));
+        auto b  = Intrin_and(Intrin_bits(a), L::set1(0x7fff'ffff));
+        auto e  = Intrin_cvtt(Intrin_add(Intrin_float(b), L::set1(1.f)));
+        Fp   m  = Intrin_sub(r, Intrin_mul(Intrin_cvt(Intrin_and(d, L::set1(1))), hp));
+        auto p  = Intrin_or(Intrin_sll<31>(e), L::set1(0x3f80'0000));
+        Fp   t  = Intrin_mul(Intrin_float(p), m);
+
+        Fp   h  = Intrin_div(t, L::set1(9.f));
+        Fp   h2 = Intrin_mul(h, h);
+        Fp   l  = Intrin_sub(Intrin_mul(L::set1(0.000027553f), h2), L::set1(0.0001984f));
+        l = Intrin_add(Intrin_mul(l, h2), L::set1(0.0083333f));
+        l = Intrin_sub(Intrin_mul(l, h2), L::set1(0.1666666f));
+        l = Intrin_add(Intrin_mul(Intrin_mul(l, h), h2), h);
+        Fp   c3 = L::set1(3.f);
+        Fp   c4 = L::set1(4.f);
+        Fp   j  = Intrin_mul(l, Intrin_sub(c3, Intrin_mul(c4, Intrin_mul(l, l))));
+        Fp   y  = Intrin_mul(j, Intrin_sub(c3, Intrin_mul(c4, Intrin_mul(j, j))));
+        return Intrin_mul(s, y);
+    }
+    template <class Fp> Fp cos(Fp x) {
+        using L = lane<Fp>;
+        Fp   pi_ = L::set1(pi<float32_t>);
+        Fp   f  = Intrin_div(x, pi_);
+        auto q  = Intrin_cvtt(f);
+        Fp   r  = Intrin_mul(Intrin_sub(f, Intrin_cvt(q)), pi_);
+        auto d  = Intrin_and(q, L::set1(1));
+        Fp   s  = Intrin_float(Intrin_or(Intrin_sll<31>(d), L::set1(0x3f80'0000)));
+        Fp   t  = Intrin_add(Intrin_mul(s, r), Intrin_mul(Intrin_cvt(d), pi_));
+
+        Fp   h  = Intrin_div(t, L::set1(27.f));
+        Fp   h2 = Intrin_mul(h, h);
+        Fp   l  = Intrin_sub(Intrin_mul(L::set1(0.000024797f), h2), L::set1(0.001388888f));
+        l = Intrin_add(Intrin_mul(l, h2), L::set1(0.04166666f));
+        l = Intrin_sub(Intrin_mul(l, h2), L::set1(0.49999999f));
+        l = Intrin_add(Intrin_mul(l, h2), L::set1(1.f));
+        Fp   c3 = L::set1(3.f);
+        Fp   c4 = L::set1(4.f);
+        Fp   b  = Intrin_mul(l, Intrin_sub(Intrin_mul(c4, Intrin_mul(l, l)), c3));
+        Fp   e  = Intrin_mul(b, Intrin_sub(Intrin_mul(c4, Intrin_mul(b, b)), c3));
+        return Intrin_mul(e, Intrin_sub(Intrin_mul(c4, Intrin_mul(e, e)), c3));
+    }
+    template <class Fp> Fp tan(Fp x) {
+        using L = lane<Fp>;
+        Fp   hp = L::set1(halfpi<float32_t>);
+        auto i  = Intrin_bits(x);
+        Fp   s  = Intrin_float(Intrin_or(Intrin_and(i, L::set1(static_cast<int32_t>(0x8000'0000))), L::set1(0x3f80'0000)));
+        Fp   v  = Intrin_float(Intrin_and(i, L::set1(0x7fff'ffff)));
+        Fp   f  = Intrin_div(v, hp);
+        auto q  = Intrin_cvtt(f);
+        Fp   r  = Intrin_mul(Intrin_sub(f, Intrin_cvt(q)), hp);
+        Fp   t  = Intrin_sub(r, Intrin_mul(Intrin_cvt(Intrin_and(q, L::set1(1))), hp));
+
+        Fp   h  = Intrin_div(t, L::set1(4.f));
+        Fp   h2 = Intrin_mul(h, h);
+        Fp   o  = L::set1(1.f);
+        Fp   l  = Intrin_add(L::set1(0.1333333f), Intrin_mul(h2, L::set1(0.05396825f)));
+        l = Intrin_add(L::set1(0.333333f), Intrin_mul(h2, l));
+        l = Intrin_mul(h, Intrin_add(o, Intrin_mul(h2, l)));
+        Fp   l2 = Intrin_mul(l, l);
+        Fp   nu = Intrin_mul(Intrin_mul(L::set1(4.f), l), Intrin_sub(o, l2));
+        Fp   de = Intrin_add(Intrin_sub(o, Intrin_mul(L::set1(6.f), l2)), Intrin_mul(l2, l2));
+        return Intrin_mul(s, Intrin_div(nu, de));
+    }
+    // sin(9h) with the series and two triple angle steps of sin.
+    template <class Fp> Fp Sincos_core(Fp h) {
+        using L = lane<Fp>;
+        Fp   c3 = L::set1(3.f);
+        Fp   c4 = L::set1(4.f);
+        Fp   h2 = Intrin_mul(h, h);
+        Fp   l  = Intrin_sub(Intrin_mul(L::set1(0.000027553f), h2), L::set1(0.0001984f));
+        l = Intrin_add(Intrin_mul(l, h2), L::set1(0.0083333f));
+        l = Intrin_sub(Intrin_mul(l, h2), L::set1(0.1666666f));
+        l = Intrin_add(Intrin_mul(Intrin_mul(l, h), h2), h);
+        Fp   j  = Intrin_mul(l, Intrin_sub(c3, Intrin_mul(c4, Intrin_mul(l, l))));
+        return Intrin_mul(j, Intrin_sub(c3, Intrin_mul(c4, Intrin_mul(j, j))));
+    }
+    template <class Fp> void sincos(Fp x, Fp& so, Fp& co) {
+        using L = lane<Fp>;
+        Fp   hp = L::set1(halfpi<float32_t>);
+        auto i  = Intrin_bits(x);
+        Fp   k  = Intrin_float(Intrin_and(i, L::set1(0x7fff'ffff)));
+        Fp   f  = Intrin_div(k, hp);
+        auto q  = Intrin_cvtt(f);
+        Fp   r  = Intrin_mul(Intrin_sub(f, Intrin_cvt(q)), hp);
+
+        // sin(r) and cos(r) = sin(pi/2 - r).
+        Fp   h  = Intrin_div(r, L::set1(9.f));
+        Fp   g  = Intrin_div(Intrin_sub(hp, r), L::set1(9.f));
+        Fp   sr = Sincos_core(h);
+        Fp   cr = Sincos_core(g);
+
+        auto d  = Intrin_and(q, L::set1(3));
+        auto sw = Intrin_cmpeq(Intrin_and(d, L::set1(1)), L::set1(1));
+        auto a  = Intrin_select(sw, Intrin_bits(cr), Intrin_bits(sr));
+        auto o  = Intrin_select(sw, Intrin_bits(sr), Intrin_bits(cr));
+        auto ss = Intrin_xor(Intrin_sll<30>(Intrin_and(d, L::set1(2))), Intrin_and(i, L::set1(static_cast<int32_t>(0x8000'0000))));
+        auto cs = Intrin_sll<30>(Intrin_and(Intrin_add(d, L::set1(1)), L::set1(2)));
+        so = Intrin_float(Intrin_xor(a, ss));
+        co = Intrin_float(Intrin_xor(o, cs));
+    }
+    // Inverse trig below is branch free already in primary.hpp,
+    // every ternary there is an Intrin_select here.
+    template <class Fp> Fp Asin_core(Fp t, typename lane<Fp>::int_type big) {
+        using L = lane<Fp>;
+        Fp   z = Intrin_select(big, Intrin_mul(L::set1(0.5f), Intrin_sub(L::set1(1.f), t)), Intrin_mul(t, t));
+        Fp   s = Intrin_select(big, Intrin_sqrt(z), t);
+        Fp   p = Intrin_add(Intrin_mul(L::set1(0.042163199048f), z), L::set1(0.024181311049f));
+        p = Intrin_add(Intrin_mul(p, z), L::set1(0.045470025998f));
+        p = Intrin_add(Intrin_mul(p, z), L::set1(0.074953002686f));
+        p = Intrin_add(Intrin_mul(p, z), L::set1(0.16666752422f));
+        return Intrin_add(s, Intrin_mul(Intrin_mul(s, z), p));
+    }
+    template <class Fp> Fp asin(Fp x) {
+        using L = lane<Fp>;
+        auto i   = Intrin_bits(x);
+        auto sg  = Intrin_and(i, L::set1(static_cast<int32_t>(0x8000'0000)));
+        Fp   t   = Intrin_float(Intrin_and(i, L::set1(0x7fff'ffff)));
+        auto big = Intrin_cmpgt(t, L::set1(0.5f));
+        Fp   r   = Asin_core(t, big);
+        Fp   y   = Intrin_select(big, Intrin_sub(L::set1(halfpi<float32_t>), Intrin_mul(L::set1(2.f), r)), r);
+        // |x| > 1 already is NaN through the square root.
+        return Intrin_float(Intrin_or(Intrin_bits(y), sg));
+    }
+    template <class Fp> Fp acos(Fp x) {
+        using L = lane<Fp>;
+        auto i   = Intrin_bits(x);
+        auto sg  = Intrin_and(i, L::set1(static_cast<int32_t>(0x8000'0000)));
+        Fp   t   = Intrin_float(Intrin_and(i, L::set1(0x7fff'ffff)));
+        auto big = Intrin_cmpgt(t, L::set1(0.5f));
+        Fp   r   = Asin_core(t, big);
+        Fp   n   = Intrin_float(Intrin_or(Intrin_bits(r), sg));
+        Fp   r2  = Intrin_mul(L::set1(2.f), r);
+        Fp   b   = Intrin_select(Intrin_cmpeq(sg, L::set1(0)), r2, Intrin_sub(L::set1(pi<float32_t>), r2));
+        return Intrin_select(big, b, Intrin_sub(L::set1(halfpi<float32_t>), n));
+    }
+    template <class Fp> Fp Atan_core(Fp mn, Fp mx) {
+        using L = lane<Fp>;
+        auto mid = Intrin_cmpgt(mn, Intrin_mul(L::set1(0.41421356237f), mx));
+        Fp   num = Intrin_select(mid, Intrin_sub(mn, mx), mn);
+        Fp   den = Intrin_select(mid, Intrin_add(mn, mx), mx);
+        Fp   z   = Intrin_div(num, Intrin_select(Intrin_cmpeq(den, L::set1(0.f)), L::set1(1.f), den));
+        Fp   z2  = Intrin_mul(z, z);
+        Fp   p   = Intrin_sub(Intrin_mul(L::set1(0.080537444954f), z2), L::set1(0.13877685603f));
+        p = Intrin_add(Intrin_mul(p, z2), L::set1(0.19977710648f));
+        p = Intrin_sub(Intrin_mul(p, z2), L::set1(0.33332949154f));
+        p = Intrin_add(Intrin_mul(Intrin_mul(p, z2), z), z);
+        return Intrin_add(Intrin_select(mid, L::set1(quarterpi<float32_t>), L::set1(0.f)), p);
+    }
+    template <class Fp> Fp atan(Fp x) {
+        using L = lane<Fp>;
+        Fp   o   = L::set1(1.f);
+        auto i   = Intrin_bits(x);
+        Fp   t   = Intrin_float(Intrin_and(i, L::set1(0x7fff'ffff)));
+        auto inv = Intrin_cmpgt(t, o);
+        Fp   a   = Atan_core(Intrin_select(inv, o, t), Intrin_select(inv, t, o));
+        Fp   y   = Intrin_select(inv, Intrin_sub(L::set1(halfpi<float32_t>), a), a);
+        return Intrin_float(Intrin_or(Intrin_bits(y), Intrin_and(i, L::set1(static_cast<int32_t>(0x8000'0000)))));
+    }
+    template <class Fp> Fp atan2(Fp y, Fp x) {
+        using L = lane<Fp>;
+        auto iy  = Intrin_bits(y);
+        auto ix  = Intrin_bits(x);
+        auto sm  = L::set1(static_cast<int32_t>(0x8000'0000));
+        Fp   ay  = Intrin_float(Intrin_and(iy, L::set1(0x7fff'ffff)));
+        Fp   ax  = Intrin_float(Intrin_and(ix, L::set1(0x7fff'ffff)));
+        auto sw  = Intrin_cmpgt(ay, ax);
+        Fp   mn  = Intrin_select(sw, ax, ay);
+        Fp   mx  = Intrin_select(sw, ay, ax);
+        Fp   k   = Intrin_select(Intrin_cmpgt(mx, L::set1(0x1p126f)), L::set1(0.25f), L::set1(1.f));
+        Fp   a   = Atan_core(Intrin_mul(mn, k), Intrin_mul(mx, k));
+        a = Intrin_select(sw, Intrin_sub(L::set1(halfpi<float32_t>), a), a);
+        a = Intrin_select(Intrin_cmpeq(Intrin_and(ix, sm), sm), Intrin_sub(L::set1(pi<float32_t>), a), a);
+        return Intrin_float(Intrin_or(Intrin_bits(a), Intrin_and(iy, sm)));
+    }
+#endif
+}
+}
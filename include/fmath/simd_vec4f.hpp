@@ -0,0 +1,178 @@
+#pragma once
+#include "basic_vector.hpp"
+#include "simd_decl.hpp"
+
+#include <emmintrin.h>
+
+namespace force::math {
+    // _MM_SHUFFLE immediate for lanes I0..I3, lowest lane first like swizzle<>.
+    // GCC makes _mm_shuffle_ps a macro at -O0, so pass it in parentheses:
+    // _mm_shuffle_ps(a, b, (Swizzle_imm<0, 1, 0, 1>)).
+    template <std::size_t I0, std::size_t I1, std::size_t I2, std::size_t I3>
+    constexpr int Swizzle_imm = static_cast<int>((I3 << 6) | (I2 << 4) | (I1 << 2) | I0);
+
+    // vec4f (basic_vector<float32_t, 4, pipe4f>) kept in one __m128.
+    // Same interface as basic_vector, so everything written against
+    // the generic template keeps working, only faster.
+    // Constant evaluation can't run intrinsics, there everything works
+    // on vdata (the member constexpr constructors start) in plain loops.
+    template <>
+    class basic_vector<float32_t, 4, pipe4f> {
+    public:
+        union {
+            alignas(16) float32_t vdata[4];
+            __m128                idata;
+        };
+        using value_type = float32_t;
+        using pipe_type  = pipe4f;
+        using view_type  = pipe4f::view_type;
+
+        static constexpr std::size_t dimension = 4;
+
+        constexpr basic_vector() : vdata{} {}
+        // This constructor is only avalable for simd types.
+        basic_vector(__m128 t) : idata(t) {}
+        // Missing elements are zero, extra ones are ignored.
+        constexpr basic_vector(std::initializer_list<value_type> lst) : vdata{} {
+            std::copy(lst.begin(), lst.begin() + std::min(dimension, lst.size()), vdata);
+        }
+        // pipe constructor can use to do conversions.
+        constexpr basic_vector(const pipe_type& v) : vdata{} {
+            std::copy(v.vdata, v.vdata + std::min(dimension, v.vsize), vdata);
+        }
+        // Views are read in place, *v3 | 1.f goes straight into the register.
+        constexpr basic_vector(const view_type& v) : vdata{} {
+            v.copy_to(vdata, dimension);
+        }
+        constexpr basic_vector(const basic_vector& right)            = default;
+        constexpr basic_vector(basic_vector&& right)                 = default;
+        constexpr basic_vector& operator=(const basic_vector& right) = default;
+        constexpr basic_vector& operator=(basic_vector&& right)      = default;
+        // Only the first vsize elements are replaced, like the generic one.
+        constexpr basic_vector& operator=(const pipe_type& v) {
+            std::copy(v.vdata, v.vdata + std::min(dimension, v.vsize), vdata);
+            return *this;
+        }
+        // The view may point into *this, so it goes through a copy.
+        constexpr basic_vector& operator=(const view_type& v) {
+            basic_vector tmp(*this);
+            v.copy_to(tmp.vdata, dimension);
+            return *this = tmp;
+        }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_vector>
+        basic_vector(const E& e)                { Expr_assign<Expr_set>(vdata, e); }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_vector>
+        basic_vector& operator=(const E& e)     { Expr_assign<Expr_set>(vdata, e); return *this; }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_vector>
+        basic_vector& operator+=(const E& e)    { Expr_assign<Expr_add>(vdata, e); return *this; }
+        template <Expression E> requires std::is_same_v<typename E::expr_result, basic_vector>
+        basic_vector& operator-=(const E& e)    { Expr_assign<Expr_sub>(vdata, e); return *this; }
+        constexpr basic_vector& operator+=(const basic_vector& right) {
+            if (std::is_constant_evaluated()) for (std::size_t i = 0; i < dimension; ++i) vdata[i] += right.vdata[i];
+            else idata = _mm_add_ps(idata, right.idata);
+            return *this;
+        }
+        constexpr basic_vector& operator-=(const basic_vector& right) {
+            if (std::is_constant_evaluated()) for (std::size_t i = 0; i < dimension; ++i) vdata[i] -= right.vdata[i];
+            else idata = _mm_sub_ps(idata, right.idata);
+            return *this;
+        }
+        constexpr basic_vector& operator*=(const value_type& k) {
+            if (std::is_constant_evaluated()) for (std::size_t i = 0; i < dimension; ++i) vdata[i] *= k;
+            else idata = _mm_mul_ps(idata, _mm_set1_ps(k));
+            return *this;
+        }
+        constexpr basic_vector& operator/=(const value_type& k) {
+            if (std::is_constant_evaluated()) for (std::size_t i = 0; i < dimension; ++i) vdata[i] /= k;
+            else idata = _mm_div_ps(idata, _mm_set1_ps(k));
+            return *this;
+        }
+        constexpr value_type&       operator[](size_t i)       { return vdata[i]; }
+        constexpr const value_type& operator[](size_t i) const { return vdata[i]; }
+        constexpr view_type         operator*() const          { return view_type(vdata, dimension); }
+
+        template <typename ... Indecies, std::size_t ArgDim = sizeof...(Indecies)>
+        constexpr basic_vector<float32_t, ArgDim, pipe4f>    operator()(Indecies ... idx) const {
+            basic_vector<float32_t, ArgDim, pipe4f>  rVec{};
+            std::initializer_list<std::size_t>  ids = { (std::size_t)idx... };
+            for (std::size_t i = 0; i < ArgDim; ++i) rVec[i] = vdata[*(ids.begin() + i)];
+            return rVec;
+        }
+        // Four indices are one shufps, fewer an unrolled copy.
+        template <std::size_t ... I>
+        constexpr basic_vector<float32_t, sizeof...(I), pipe4f> swizzle() const {
+            static_assert(sizeof...(I) > 0 && ((I < 4) && ...), "Swizzle index out of range!");
+            if constexpr (sizeof...(I) == 4)
+                if (!std::is_constant_evaluated()) return _mm_shuffle_ps(idata, idata, (Swizzle_imm<I...>));
+            basic_vector<float32_t, sizeof...(I), pipe4f> rVec;
+            std::size_t k = 0;
+            ((rVec.vdata[k++] = vdata[I]), ...);
+            return rVec;
+        }
+        constexpr auto xy()   const { return swizzle<0, 1>(); }
+        constexpr auto xyz()  const { return swizzle<0, 1, 2>(); }
+        constexpr auto yzx()  const { return swizzle<1, 2, 0>(); }
+        constexpr auto zxy()  const { return swizzle<2, 0, 1>(); }
+        constexpr auto yzxw() const { return swizzle<1, 2, 0, 3>(); }
+        constexpr auto zxyw() const { return swizzle<2, 0, 1, 3>(); }
+        constexpr auto wzyx() const { return swizzle<3, 2, 1, 0>(); }
+        constexpr auto xxxx() const { return swizzle<0, 0, 0, 0>(); }
+        constexpr auto yyyy() const { return swizzle<1, 1, 1, 1>(); }
+        constexpr auto zzzz() const { return swizzle<2, 2, 2, 2>(); }
+        constexpr auto wwww() const { return swizzle<3, 3, 3, 3>(); }
+
+        ~basic_vector() = default;
+    };
+
+    // Horizontal sum of a*b in every lane.
+    inline __m128 Vec4f_dot(__m128 a, __m128 b) {
+        __m128 c = _mm_mul_ps(a, b);
+        c = _mm_add_ps(c, _mm_shuffle_ps(c, c, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(c, _mm_shuffle_ps(c, c, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+
+    // The compound operators above already pick the path.
+    [[nodiscard]] constexpr const basic_vector<float32_t, 4, pipe4f> operator+(const basic_vector<float32_t, 4, pipe4f>& a,
+                                                                              const basic_vector<float32_t, 4, pipe4f>& b) {
+        basic_vector<float32_t, 4, pipe4f> r(a);
+        return r += b;
+    }
+    [[nodiscard]] constexpr const basic_vector<float32_t, 4, pipe4f> operator-(const basic_vector<float32_t, 4, pipe4f>& a,
+                                                                              const basic_vector<float32_t, 4, pipe4f>& b) {
+        basic_vector<float32_t, 4, pipe4f> r(a);
+        return r -= b;
+    }
+    [[nodiscard]] constexpr const basic_vector<float32_t, 4, pipe4f> operator*(const basic_vector<float32_t, 4, pipe4f>& a, float32_t k) {
+        basic_vector<float32_t, 4, pipe4f> r(a);
+        return r *= k;
+    }
+    [[nodiscard]] constexpr const basic_vector<float32_t, 4, pipe4f> operator/(const basic_vector<float32_t, 4, pipe4f>& a, float32_t k) {
+        basic_vector<float32_t, 4, pipe4f> r(a);
+        return r /= k;
+    }
+    [[nodiscard]] constexpr const basic_vector<float32_t, 4, pipe4f> operator-(const basic_vector<float32_t, 4, pipe4f>& a) {
+        basic_vector<float32_t, 4, pipe4f> r;
+        return r -= a;
+    }
+    // Equal within epsilon in every lane, like the generic one.
+    [[nodiscard]] constexpr bool operator==(const basic_vector<float32_t, 4, pipe4f>& a, const basic_vector<float32_t, 4, pipe4f>& b) {
+        if (std::is_constant_evaluated()) {
+            for (std::size_t i = 0; i < 4; ++i)
+                if (abs(a[i] - b[i]) > std::numeric_limits<float32_t>::epsilon()) return false;
+            return true;
+        }
+        __m128 d = _mm_andnot_ps(_mm_set1_ps(-0.f), _mm_sub_ps(a.idata, b.idata));
+        return _mm_movemask_ps(_mm_cmpgt_ps(d, _mm_set1_ps(std::numeric_limits<float32_t>::epsilon()))) == 0;
+    }
+    constexpr float32_t dot(const basic_vector<float32_t, 4, pipe4f>& a, const basic_vector<float32_t, 4, pipe4f>& b) {
+        if (std::is_constant_evaluated()) return a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+        return _mm_cvtss_f32(Vec4f_dot(a.idata, b.idata));
+    }
+    constexpr float32_t length(const basic_vector<float32_t, 4, pipe4f>& a) {
+        return sqrt(dot(a, a));
+    }
+    constexpr basic_vector<float32_t, 4, pipe4f> norm(const basic_vector<float32_t, 4, pipe4f>& a) {
+        if (std::is_constant_evaluated()) return a * rsqrt(dot(a, a));
+        return _mm_mul_ps(a.idata, _mm_set1_ps(rsqrt(_mm_cvtss_f32(Vec4f_dot(a.idata, a.idata)))));
+    }
+}
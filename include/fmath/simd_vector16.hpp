@@ -0,0 +1,101 @@
+#pragma once
+#include "basic_vector.hpp"
+#include "simd_decl.hpp"
+
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+#define  SIMD_VECTOR16x32 true
+
+namespace force::math {
+
+    // Register for 16 lanes of Ty, see SIMDRegister4.
+    template <typename Ty> struct SIMDRegister16        { using type = __m512i; };
+    template <>            struct SIMDRegister16<float> { using type = __m512; };
+
+    // 16 lane version of SIMDVector4 on AVX-512 registers.
+    // Only there when the whole build targets AVX-512F, same interface.
+    template <typename Ty>
+    class SIMDVector16 {
+    public:
+        using SIMDType = typename SIMDRegister16<Ty>::type;
+        static_assert(std::is_same_v<Ty, float> | std::is_same_v<Ty, int>, "Not uint32 nor float types are not supported!");
+        // Only 4byte types such as int, unsigned int, float support
+        union {
+            alignas(64) Ty                 vdata[16];
+            SIMDType                       idata;
+        };
+
+        using value_type = Ty;
+        using pipe_type  = basic_pipe<Ty, 16>;
+
+        static constexpr std::size_t dimension = 16;
+
+        SIMDVector16();
+        // This constructor is only avalable for simd types.
+        SIMDVector16(SIMDType t);
+        // Missing elements of a short list are zero.
+        SIMDVector16(std::initializer_list<value_type> lst);
+        // pipe constructor can use to do conversions.
+        SIMDVector16(const pipe_type& v);
+        // Trivial copies, the vector travels in one register.
+        SIMDVector16(const SIMDVector16& right)            = default;
+        SIMDVector16(SIMDVector16&& right)                 = default;
+        SIMDVector16& operator=(const SIMDVector16& right) = default;
+        SIMDVector16& operator=(SIMDVector16&& right)      = default;
+        SIMDVector16& operator=(const pipe_type& v);
+        SIMDVector16& operator+=(const SIMDVector16& right);
+        SIMDVector16& operator-=(const SIMDVector16& right);
+        SIMDVector16& operator*=(const value_type& k);
+        SIMDVector16& operator/=(const value_type& k);
+
+        const SIMDVector16     operator+(const SIMDVector16& right) const;
+        const SIMDVector16     operator-(const SIMDVector16& right) const;
+        const SIMDVector16     operator*(const value_type& k) const;
+        const SIMDVector16     operator/(const value_type& k) const;
+
+        value_type&       operator[](size_t i) { return vdata[i]; }
+        const value_type& operator[](size_t i) const { return vdata[i]; }
+        pipe_type         operator*() const { return basic_pipe<Ty, 16>(vdata, 16); }
+
+        // This one can't have simd optimization.
+        template <typename ... Indecies, std::size_t ArgDim = sizeof...(Indecies)>
+        basic_vector<Ty, ArgDim, basic_pipe<Ty, 16>>        operator()(Indecies ... idx) const {
+            basic_vector<Ty, ArgDim, basic_pipe<Ty, 16>>  rVec{};
+            std::initializer_list<std::size_t>  ids = { (std::size_t)idx... };
+            for (std::size_t i = 0; i < ArgDim; ++i) rVec[i] = vdata[*(ids.begin() + i)];
+            return rVec;
+        }
+
+        ~SIMDVector16() = default;
+    };
+
+    template <typename Ty> const SIMDVector16<Ty> operator+ (const SIMDVector16<Ty>& a);
+    template <typename Ty> const SIMDVector16<Ty> operator- (const SIMDVector16<Ty>& a);
+    template <typename Ty> const bool            operator==(const SIMDVector16<Ty>& a, const SIMDVector16<Ty>& b);
+
+    template <typename Ty> const Ty              length(const SIMDVector16<Ty>& a);
+    template <typename Ty> const Ty              dot(const SIMDVector16<Ty>& a, const SIMDVector16<Ty>& b);
+    template <typename Ty> const SIMDVector16<Ty> norm(const SIMDVector16<Ty>& a);
+
+#ifndef FORCE_INLINE_MATH
+    ////////////////////////////////////////////////////////////////////
+    // Instantiated once in simd_vector16.cpp.
+    ////////////////////////////////////////////////////////////////////
+    extern template class SIMDVector16<float>;
+    extern template class SIMDVector16<int>;
+    extern template const SIMDVector16<float> operator+ (const SIMDVector16<float>& a);
+    extern template const SIMDVector16<int>   operator+ (const SIMDVector16<int>& a);
+    extern template const SIMDVector16<float> operator- (const SIMDVector16<float>& a);
+    extern template const SIMDVector16<int>   operator- (const SIMDVector16<int>& a);
+    extern template const bool               operator==(const SIMDVector16<float>& a, const SIMDVector16<float>& b);
+    extern template const bool               operator==(const SIMDVector16<int>& a, const SIMDVector16<int>& b);
+
+    extern template const float              length(const SIMDVector16<float>& a);
+    extern template const float              dot(const SIMDVector16<float>& a, const SIMDVector16<float>& b);
+    extern template const SIMDVector16<float> norm(const SIMDVector16<float>& a);
+#endif
+}
+
+#ifdef FORCE_INLINE_MATH
+#include "simd_vector16.inl"
+#endif
+#endif
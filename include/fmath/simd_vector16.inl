@@ -0,0 +1,135 @@
+// Definitions of SIMDVector16 members and functions.
+// Compiled once into force_lib by simd_vector16.cpp, or included by
+// simd_vector16.hpp itself when FORCE_INLINE_MATH is defined.
+#pragma once
+#include "simd_vector16.hpp"
+#include "simd_primary.hpp"
+
+namespace force::math {
+    template <typename Ty>
+    using SIMDType16 = SIMDVector16<Ty>::SIMDType;
+
+    template <typename Ty>
+    inline SIMDType16<Ty> Intrin16_set1(Ty v) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm512_set1_ps(v);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm512_set1_epi32(v);
+    }
+    template <typename Ty>
+    inline SIMDType16<Ty> Intrin16_load(const Ty* const d) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm512_loadu_ps(d);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm512_loadu_si512(d);
+    }
+    template <typename Ty>
+    inline SIMDType16<Ty> Intrin16_add(const SIMDType16<Ty>& a, const SIMDType16<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm512_add_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm512_add_epi32(a, b);
+    }
+    template <typename Ty>
+    inline SIMDType16<Ty> Intrin16_sub(const SIMDType16<Ty>& a, const SIMDType16<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm512_sub_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm512_sub_epi32(a, b);
+    }
+    template <typename Ty>
+    inline SIMDType16<Ty> Intrin16_mul(const SIMDType16<Ty>& a, const SIMDType16<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm512_mul_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm512_mullo_epi32(a, b);
+    }
+    template <typename Ty>
+    inline SIMDType16<Ty> Intrin16_div(const SIMDType16<Ty>& a, Ty k) {
+        if constexpr (std::is_same_v<Ty, float>) return _mm512_div_ps(a, _mm512_set1_ps(k));
+        else if constexpr (std::is_same_v<Ty, int>) {
+            // No integer divide instruction, lane by lane.
+            alignas(64) int v[16];
+            _mm512_store_si512(v, a);
+            for (int& e : v) e /= k;
+            return _mm512_load_si512(v);
+        }
+    }
+    template <typename Ty>
+    inline Ty Intrin16_dot(const SIMDType16<Ty>& a, const SIMDType16<Ty>& b) {
+        static_assert(std::is_same_v<Ty, float>, "Interger vector does not support dot product!");
+
+        if constexpr (std::is_same_v<Ty, float>) {
+            return _mm512_reduce_add_ps(_mm512_mul_ps(a, b));
+        }
+    }
+
+    template <typename Ty>
+    SIMDVector16<Ty>::SIMDVector16(SIMDVector16<Ty>::SIMDType t) : idata(t) {}
+
+    template <typename Ty>
+    SIMDVector16<Ty>::SIMDVector16() : idata(Intrin16_set1<Ty>(static_cast<Ty>(0))) {}
+
+    template <typename Ty>
+    SIMDVector16<Ty>::SIMDVector16(std::initializer_list<Ty> lst) : idata(Intrin16_set1<Ty>(static_cast<Ty>(0))) {
+        std::copy(lst.begin(), lst.begin() + std::min<std::size_t>(lst.size(), 16), vdata);
+    }
+    template <typename Ty>
+    SIMDVector16<Ty>::SIMDVector16(const pipe_type& p) : idata(Intrin16_load<Ty>(p.vdata)) {}
+    template <typename Ty>
+    SIMDVector16<Ty>& SIMDVector16<Ty>::operator=(const pipe_type& right) {
+        idata = Intrin16_load<Ty>(right.vdata);
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector16<Ty>& SIMDVector16<Ty>::operator+=(const SIMDVector16<Ty>& right) {
+        idata = Intrin16_add<Ty>(idata, right.idata);
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector16<Ty>& SIMDVector16<Ty>::operator-=(const SIMDVector16<Ty>& right) {
+        idata = Intrin16_sub<Ty>(idata, right.idata);
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector16<Ty>& SIMDVector16<Ty>::operator*=(const Ty& right) {
+        idata = Intrin16_mul<Ty>(idata, Intrin16_set1<Ty>(right));
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector16<Ty>& SIMDVector16<Ty>::operator/=(const Ty& right) {
+        idata = Intrin16_div<Ty>(idata, right);
+        return *this;
+    }
+    template <typename Ty>
+    const SIMDVector16<Ty> SIMDVector16<Ty>::operator+(const SIMDVector16<Ty>& right) const {
+        return Intrin16_add<Ty>(idata, right.idata);
+    }
+    template <typename Ty>
+    const SIMDVector16<Ty> SIMDVector16<Ty>::operator-(const SIMDVector16<Ty>& right) const {
+        return Intrin16_sub<Ty>(idata, right.idata);
+    }
+    template <typename Ty>
+    const SIMDVector16<Ty> SIMDVector16<Ty>::operator*(const Ty& right) const {
+        return Intrin16_mul<Ty>(idata, Intrin16_set1<Ty>(right));
+    }
+    template <typename Ty>
+    const SIMDVector16<Ty> SIMDVector16<Ty>::operator/(const Ty& right) const {
+        return Intrin16_div<Ty>(idata, right);
+    }
+
+    // Functions.
+    template <typename Ty> const SIMDVector16<Ty> operator+(const SIMDVector16<Ty>& a) {
+        return a;
+    }
+    template <typename Ty> const SIMDVector16<Ty> operator-(const SIMDVector16<Ty>& a) {
+        return Intrin16_sub<Ty>(Intrin16_set1<Ty>(0), a.idata);
+    }
+    template <typename Ty> const Ty              dot(const SIMDVector16<Ty>& a, const SIMDVector16<Ty>& b) {
+        return Intrin16_dot<Ty>(a.idata, b.idata);
+    }
+    template <typename Ty> const Ty              length(const SIMDVector16<Ty>& a) {
+        return sqrt(Intrin16_dot<Ty>(a.idata, a.idata));
+    }
+    template <typename Ty> const SIMDVector16<Ty> norm(const SIMDVector16<Ty>& a) {
+        auto k = rsqrt(Intrin16_dot<Ty>(a.idata, a.idata));
+        return Intrin16_mul<Ty>(a.idata, Intrin16_set1<Ty>(k));
+    }
+    template <typename Ty>
+    const bool operator==(const SIMDVector16<Ty>& a, const SIMDVector16<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, int>)
+            return _mm512_cmpeq_epi32_mask(a.idata, b.idata) == 0xffff;
+        else if constexpr (std::is_same_v<Ty, float>)
+            return _mm512_cmp_ps_mask(a.idata, b.idata, _CMP_EQ_OQ) == 0xffff;
+    }
+}
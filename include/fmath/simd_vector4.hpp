@@ -5,13 +5,44 @@
 
 namespace force::math {
 
+    // Lane mask from the SIMDVector4 comparisons, all ones where true.
+    // Feed it to select() or collapse it with any/all/none, that keeps
+    // per lane decisions (clamping, culling, hit tests) free of branches.
+    class SIMDMask4 {
+    public:
+        __m128i idata;
+
+        SIMDMask4(__m128i m) : idata(m) {}
+
+        // Lane i is bit i.
+        int  bits() const { return _mm_movemask_ps(_mm_castsi128_ps(idata)); }
+        bool any()  const { return bits() != 0; }
+        bool all()  const { return bits() == 0xf; }
+        bool none() const { return bits() == 0; }
+
+        SIMDMask4 operator&(const SIMDMask4& m) const { return _mm_and_si128(idata, m.idata); }
+        SIMDMask4 operator|(const SIMDMask4& m) const { return _mm_or_si128(idata, m.idata); }
+        SIMDMask4 operator^(const SIMDMask4& m) const { return _mm_xor_si128(idata, m.idata); }
+        SIMDMask4 operator~() const { return _mm_xor_si128(idata, _mm_set1_epi32(-1)); }
+    };
+    inline bool any (const SIMDMask4& m) { return m.any(); }
+    inline bool all (const SIMDMask4& m) { return m.all(); }
+    inline bool none(const SIMDMask4& m) { return m.none(); }
+
+#if FMA_ARCH & FMA_ARCH_X86
+    // Register for 4 lanes of Ty. std::conditional_t<.., __m128, __m128i> would
+    // pass the vector types as template arguments, which GCC warns about.
+    template <typename Ty> struct SIMDRegister4        { using type = __m128i; };
+    template <>            struct SIMDRegister4<float> { using type = __m128; };
+#endif
+
     // Specialization for SIMDVector4<float, 4, Vec4fPipe>
     // Whic is simd_vector4 uses SSE2 intrinsics (Atleast)
     template <typename Ty>
     class SIMDVector4 {
     public:
 #if FMA_ARCH & FMA_ARCH_X86
-        using SIMDType = typename std::conditional_t<std::is_same_v<Ty, float>, __m128, __m128i>;
+        using SIMDType = typename SIMDRegister4<Ty>::type;
 #endif
         static_assert(std::is_same_v<Ty, float> | std::is_same_v<Ty, int>, "Not uint32 nor float types are not supported!");
         // Only 4byte types such as int, unsigned int, float support
@@ -34,10 +65,11 @@ namespace force::math {
         SIMDVector4(std::initializer_list<value_type> lst);
         // pipe constructor can use to do conversions.
         SIMDVector4(const pipe_type& v);
-        SIMDVector4(const SIMDVector4& right) noexcept;
-        SIMDVector4(SIMDVector4&& right)      noexcept;
-
-        SIMDVector4& operator=(const SIMDVector4& right);
+        // Trivial copies, the vector travels in one register.
+        SIMDVector4(const SIMDVector4& right)            = default;
+        SIMDVector4(SIMDVector4&& right)                 = default;
+        SIMDVector4& operator=(const SIMDVector4& right) = default;
+        SIMDVector4& operator=(SIMDVector4&& right)      = default;
         SIMDVector4& operator=(const pipe_type& v);
         SIMDVector4& operator+=(const SIMDVector4& right);
         SIMDVector4& operator-=(const SIMDVector4& right);
@@ -61,31 +93,150 @@ namespace force::math {
             for (std::size_t i = 0; i < ArgDim; ++i) rVec[i] = vdata[*(ids.begin() + i)];
             return rVec;
         }
+        // Compile-time shuffle, v.swizzle<2, 1, 0, 3>().
+        // Four indices stay a SIMDVector4 in one shufps/pshufd, fewer give an unrolled basic_vector.
+        template <std::size_t ... I>
+        auto swizzle() const {
+            static_assert(sizeof...(I) > 0 && ((I < 4) && ...), "Swizzle index out of range!");
+            if constexpr (sizeof...(I) == 4) {
+                if constexpr (std::is_same_v<Ty, float>) return SIMDVector4(_mm_shuffle_ps(idata, idata, (Swizzle_imm<I...>)));
+                else                                     return SIMDVector4(_mm_shuffle_epi32(idata, (Swizzle_imm<I...>)));
+            }
+            else {
+                basic_vector<Ty, sizeof...(I), basic_pipe<Ty, 4>> rVec;
+                std::size_t k = 0;
+                ((rVec.vdata[k++] = vdata[I]), ...);
+                return rVec;
+            }
+        }
+        auto xy()   const { return swizzle<0, 1>(); }
+        auto xyz()  const { return swizzle<0, 1, 2>(); }
+        auto yzx()  const { return swizzle<1, 2, 0>(); }
+        auto zxy()  const { return swizzle<2, 0, 1>(); }
+        auto yzxw() const { return swizzle<1, 2, 0, 3>(); }
+        auto zxyw() const { return swizzle<2, 0, 1, 3>(); }
+        auto wzyx() const { return swizzle<3, 2, 1, 0>(); }
+        auto xxxx() const { return swizzle<0, 0, 0, 0>(); }
+        auto yyyy() const { return swizzle<1, 1, 1, 1>(); }
+        auto zzzz() const { return swizzle<2, 2, 2, 2>(); }
+        auto wwww() const { return swizzle<3, 3, 3, 3>(); }
 
         ~SIMDVector4() = default;
     };
 
+    // Division of int lanes by a divisor fixed at run time (grid cell size, bucket count).
+    // The constructor works out a magic multiplier once, every divide after that is
+    // a multiply-high, an add and two shifts instead of the divpd of operator/(int).
+    // Rounds toward zero like int division, d = 0 throws.
+    class SIMDDivisor4 {
+    public:
+        SIMDDivisor4(int32_t d);
+
+        __m128i divide(__m128i n) const;
+        // Same result for one value, for loop tails.
+        int32_t divide(int32_t n) const;
+
+        int32_t value() const { return divisor; }
+    private:
+        __m128i magic, shift, addn, negn, round;
+        int32_t divisor;
+    };
+    const SIMDVector4<int>  operator/ (const SIMDVector4<int>& a, const SIMDDivisor4& d);
+    SIMDVector4<int>&       operator/=(SIMDVector4<int>& a, const SIMDDivisor4& d);
+
     template <typename Ty> const SIMDVector4<Ty> operator+ (const SIMDVector4<Ty>& a);
     template <typename Ty> const SIMDVector4<Ty> operator- (const SIMDVector4<Ty>& a);
     template <typename Ty> const bool            operator==(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
 
+    // Lane-wise comparisons. operator== stays the all lanes bool, equal() is its mask.
+    template <typename Ty> const SIMDMask4       operator< (const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
+    template <typename Ty> const SIMDMask4       operator<=(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
+    template <typename Ty> const SIMDMask4       operator> (const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
+    template <typename Ty> const SIMDMask4       operator>=(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
+    template <typename Ty> const SIMDMask4       operator!=(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
+    template <typename Ty> const SIMDMask4       equal(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
+
+    // a where m is set, b elsewhere.
+    template <typename Ty> const SIMDVector4<Ty> select(const SIMDMask4& m, const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
+    template <typename Ty> const SIMDVector4<Ty> min(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
+    template <typename Ty> const SIMDVector4<Ty> max(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
+    template <typename Ty> const SIMDVector4<Ty> clamp(const SIMDVector4<Ty>& x, const SIMDVector4<Ty>& lo, const SIMDVector4<Ty>& hi);
+    // Sum, min and max of the four lanes.
+    template <typename Ty> const Ty              hsum(const SIMDVector4<Ty>& a);
+    template <typename Ty> const Ty              hmin(const SIMDVector4<Ty>& a);
+    template <typename Ty> const Ty              hmax(const SIMDVector4<Ty>& a);
+
     template <typename Ty> const Ty              length(const SIMDVector4<Ty>& a);
     template <typename Ty> const Ty              dot(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b);
     template <typename Ty> const SIMDVector4<Ty> norm(const SIMDVector4<Ty>& a);
 
+    // Cross product of the xyz lanes, w comes out 0.
+    const SIMDVector4<float> cross(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+
+    // Lane-wise sin and cos sharing one range reduction.
+    void sincos(const SIMDVector4<float>& x, SIMDVector4<float>& s, SIMDVector4<float>& c);
 
+    // Lane-wise primary functions, the simd_primary.hpp kernels on one register.
+    // Same accuracy as the scalar ones except sqrt (exact, sqrtps) and rsqrt (rsqrtps
+    // and one Newton step, ~22 bits). floor and round keep float lanes
+    // and the sign of zero, round(-0.3) is -0.
+    const SIMDVector4<float> sin  (const SIMDVector4<float>& x);
+    const SIMDVector4<float> cos  (const SIMDVector4<float>& x);
+    const SIMDVector4<float> exp  (const SIMDVector4<float>& x);
+    const SIMDVector4<float> log  (const SIMDVector4<float>& x);
+    const SIMDVector4<float> sqrt (const SIMDVector4<float>& x);
+    const SIMDVector4<float> rsqrt(const SIMDVector4<float>& x);
+    const SIMDVector4<float> abs  (const SIMDVector4<float>& x);
+    const SIMDVector4<float> floor(const SIMDVector4<float>& x);
+    const SIMDVector4<float> round(const SIMDVector4<float>& x);
+
+
+#ifndef FORCE_INLINE_MATH
     ////////////////////////////////////////////////////////////////////
-    // Explicitly template only for these functions defined in cpp file.
+    // Instantiated once in simd_vector4.cpp.
     ////////////////////////////////////////////////////////////////////
-    template const SIMDVector4<float> operator+ (const SIMDVector4<float>& a);
-    template const SIMDVector4<int>   operator+ (const SIMDVector4<int>& a);
-    template const SIMDVector4<float> operator- (const SIMDVector4<float>& a);
-    template const SIMDVector4<int>   operator- (const SIMDVector4<int>& a);
-    template const bool               operator==(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
-    template const bool               operator==(const SIMDVector4<int>& a, const SIMDVector4<int>& b);
-
-    template const float              length(const SIMDVector4<float>& a);
-    template const float              dot(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
-    template const SIMDVector4<float> norm(const SIMDVector4<float>& a);
-
-}
\ No newline at end of file
+    extern template const SIMDVector4<float> operator+ (const SIMDVector4<float>& a);
+    extern template const SIMDVector4<int>   operator+ (const SIMDVector4<int>& a);
+    extern template const SIMDVector4<float> operator- (const SIMDVector4<float>& a);
+    extern template const SIMDVector4<int>   operator- (const SIMDVector4<int>& a);
+    extern template const bool               operator==(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const bool               operator==(const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+
+    extern template const float              length(const SIMDVector4<float>& a);
+    extern template const float              dot(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDVector4<float> norm(const SIMDVector4<float>& a);
+
+    extern template const SIMDMask4          operator< (const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDMask4          operator< (const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+    extern template const SIMDMask4          operator<=(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDMask4          operator<=(const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+    extern template const SIMDMask4          operator> (const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDMask4          operator> (const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+    extern template const SIMDMask4          operator>=(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDMask4          operator>=(const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+    extern template const SIMDMask4          operator!=(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDMask4          operator!=(const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+    extern template const SIMDMask4          equal(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDMask4          equal(const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+
+    extern template const SIMDVector4<float> select(const SIMDMask4& m, const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDVector4<int>   select(const SIMDMask4& m, const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+    extern template const SIMDVector4<float> min(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDVector4<int>   min(const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+    extern template const SIMDVector4<float> max(const SIMDVector4<float>& a, const SIMDVector4<float>& b);
+    extern template const SIMDVector4<int>   max(const SIMDVector4<int>& a, const SIMDVector4<int>& b);
+    extern template const SIMDVector4<float> clamp(const SIMDVector4<float>& x, const SIMDVector4<float>& lo, const SIMDVector4<float>& hi);
+    extern template const SIMDVector4<int>   clamp(const SIMDVector4<int>& x, const SIMDVector4<int>& lo, const SIMDVector4<int>& hi);
+    extern template const float              hsum(const SIMDVector4<float>& a);
+    extern template const int                hsum(const SIMDVector4<int>& a);
+    extern template const float              hmin(const SIMDVector4<float>& a);
+    extern template const int                hmin(const SIMDVector4<int>& a);
+    extern template const float              hmax(const SIMDVector4<float>& a);
+    extern template const int                hmax(const SIMDVector4<int>& a);
+
+#endif
+}
+
+#ifdef FORCE_INLINE_MATH
+#include "simd_vector4.inl"
+#endif
@@ -0,0 +1,372 @@
+// Definitions of SIMDVector4 members and functions.
+// Compiled once into force_lib by simd_vector4.cpp, or included by
+// simd_vector4.hpp itself when FORCE_INLINE_MATH is defined.
+#pragma once
+#include "simd_vector4.hpp"
+#include "simd_primary.hpp"
+
+namespace force::math {
+    template <typename Ty>
+    using SIMDType = SIMDVector4<Ty>::SIMDType;
+
+    template <typename Ty>
+    inline SIMDType<Ty> Intrin_set1(Ty v) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_set_ps1(v);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_set1_epi32(v);
+    }
+    template <typename Ty>
+    inline SIMDType<Ty> Intrin_load(const Ty* const d) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_loadu_ps(d);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_loadu_si128(reinterpret_cast<const __m128i*>(d));
+    }
+    template <typename Ty>
+    inline SIMDType<Ty> Intrin_add(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_add_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>)  return _mm_add_epi32(a, b);
+    }
+    template <typename Ty>
+    inline SIMDType<Ty> Intrin_sub(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_sub_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>)  return _mm_sub_epi32(a, b);
+    }
+    // Low 32 bits of the lane products. SSE2 only multiplies lanes 0 and 2
+    // into 64 bits, so the odd lanes take a second pmuludq.
+    inline __m128i Intrin_mullo(__m128i a, __m128i b) {
+#if FMA_ARCH & FMA_ARCH_SSE41_BIT
+        return _mm_mullo_epi32(a, b);
+#else
+        __m128i ev = _mm_mul_epu32(a, b);
+        __m128i od = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(ev, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(od, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+    }
+    // High 32 bits of the signed lane products.
+    inline __m128i Intrin_mulhi(__m128i a, __m128i b) {
+#if FMA_ARCH & FMA_ARCH_SSE41_BIT
+        __m128i ev = _mm_mul_epi32(a, b);
+        __m128i od = _mm_mul_epi32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+#else
+        // Unsigned products, then minus b where a < 0 and minus a where b < 0.
+        __m128i ev = _mm_mul_epu32(a, b);
+        __m128i od = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+#endif
+        __m128i hi = _mm_or_si128(_mm_srli_epi64(ev, 32), _mm_and_si128(od, _mm_set_epi32(-1, 0, -1, 0)));
+#if !(FMA_ARCH & FMA_ARCH_SSE41_BIT)
+        hi = _mm_sub_epi32(hi, _mm_and_si128(_mm_srai_epi32(a, 31), b));
+        hi = _mm_sub_epi32(hi, _mm_and_si128(_mm_srai_epi32(b, 31), a));
+#endif
+        return hi;
+    }
+    template <typename Ty>
+    inline SIMDType<Ty> Intrin_mul(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_mul_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>)  return Intrin_mullo(a, b);
+    }
+    template <typename Ty>
+    inline SIMDType<Ty> Intrin_div(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_div_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>) {
+            // No integer divide instruction. Any int32 fits a double and the
+            // truncated double quotient is the exact one, two lanes per divpd.
+            __m128d lo = _mm_div_pd(_mm_cvtepi32_pd(a), _mm_cvtepi32_pd(b));
+            __m128d hi = _mm_div_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(a, 0x4e)), _mm_cvtepi32_pd(_mm_shuffle_epi32(b, 0x4e)));
+            return _mm_unpacklo_epi64(_mm_cvttpd_epi32(lo), _mm_cvttpd_epi32(hi));
+        }
+    }
+    // Dot product in every lane, for results that stay in a register.
+    template <typename Ty>
+    inline SIMDType<Ty> Intrin_dotv(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        static_assert(std::is_same_v<Ty, float>, "Interger vector does not support dot product!");
+
+        if constexpr (std::is_same_v<Ty, float>) {
+            auto c = _mm_mul_ps(a, b);
+            c = _mm_add_ps(c, _mm_shuffle_ps(c, c, 0xb1));
+            return _mm_add_ps(c, _mm_shuffle_ps(c, c, 0x4e));
+        }
+    }
+    template <typename Ty>
+    inline Ty Intrin_dot(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        static_assert(std::is_same_v<Ty, float>, "Interger vector does not support dot product!");
+
+        if constexpr (std::is_same_v<Ty, float>) {
+            auto c = _mm_mul_ps(a, b);
+            auto shuf = _mm_shuffle_ps(c, c, 0xb1);
+            auto sums = _mm_add_ps(c, shuf);
+            shuf = _mm_movehl_ps(shuf, sums);
+            sums = _mm_add_ps(sums, shuf);
+            return _mm_cvtss_f32(sums);
+        }
+    }
+    // Comparison masks as __m128i for both types.
+    template <typename Ty>
+    inline __m128i Intrin_cmplt(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_castps_si128(_mm_cmplt_ps(a, b));
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_cmplt_epi32(a, b);
+    }
+    template <typename Ty>
+    inline __m128i Intrin_cmple(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_castps_si128(_mm_cmple_ps(a, b));
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_xor_si128(_mm_cmpgt_epi32(a, b), _mm_set1_epi32(-1));
+    }
+    template <typename Ty>
+    inline __m128i Intrin_cmpeq(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_castps_si128(_mm_cmpeq_ps(a, b));
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_cmpeq_epi32(a, b);
+    }
+    template <typename Ty>
+    inline __m128i Intrin_cmpneq(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_castps_si128(_mm_cmpneq_ps(a, b));
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_xor_si128(_mm_cmpeq_epi32(a, b), _mm_set1_epi32(-1));
+    }
+    template <typename Ty>
+    inline SIMDType<Ty> Intrin_min(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_min_ps(a, b);
+#if FMA_ARCH & FMA_ARCH_SSE41_BIT
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_min_epi32(a, b);
+#else
+        else if constexpr (std::is_same_v<Ty, int>) return simd::Intrin_select(_mm_cmplt_epi32(a, b), a, b);
+#endif
+    }
+    template <typename Ty>
+    inline SIMDType<Ty> Intrin_max(const SIMDType<Ty>& a, const SIMDType<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_max_ps(a, b);
+#if FMA_ARCH & FMA_ARCH_SSE41_BIT
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_max_epi32(a, b);
+#else
+        else if constexpr (std::is_same_v<Ty, int>) return simd::Intrin_select(_mm_cmpgt_epi32(a, b), a, b);
+#endif
+    }
+    // Swaps neighbour lanes, then neighbour pairs.
+    template <typename Ty, int Imm>
+    inline SIMDType<Ty> Intrin_shuffle(const SIMDType<Ty>& a) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_shuffle_ps(a, a, Imm);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_shuffle_epi32(a, Imm);
+    }
+    template <typename Ty>
+    inline Ty Intrin_first(const SIMDType<Ty>& a) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm_cvtss_f32(a);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm_cvtsi128_si32(a);
+    }
+
+    // rsqrtps is 12 bits, one Newton step y * (1.5 - 0.5 * x * y * y) takes it to ~22.
+    inline __m128 Intrin_rsqrt(__m128 x) {
+        __m128 y = _mm_rsqrt_ps(x);
+        __m128 n = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), x), _mm_mul_ps(y, y));
+        return _mm_mul_ps(y, _mm_sub_ps(_mm_set1_ps(1.5f), n));
+    }
+
+    template <typename Ty>
+    SIMDVector4<Ty>::SIMDVector4(SIMDVector4<Ty>::SIMDType t) : idata(t) {}
+
+    template <typename Ty>
+    SIMDVector4<Ty>::SIMDVector4() : idata(Intrin_set1<Ty>(static_cast<Ty>(0))) {}
+
+    template <typename Ty>
+    SIMDVector4<Ty>::SIMDVector4(std::initializer_list<Ty> lst) : idata(Intrin_set1<Ty>(static_cast<Ty>(0))) {
+        // Then create cache
+        auto a = Intrin_load<Ty>(lst.begin());
+        // Then copy data
+        idata = a;
+    }
+    template <typename Ty>
+    SIMDVector4<Ty>::SIMDVector4(const pipe_type& p) : idata(Intrin_set1<Ty>(0)) {
+        // Then load data.
+        auto a = Intrin_load<Ty>(p.vdata);
+        // Then copy data.
+        idata = a;
+    }
+    template <typename Ty>
+    SIMDVector4<Ty>& SIMDVector4<Ty>::operator=(const pipe_type& right) {
+        idata = Intrin_load(right.vdata);
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector4<Ty>& SIMDVector4<Ty>::operator+=(const SIMDVector4<Ty>& right) {
+        idata = Intrin_add<Ty>(idata, right.idata);
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector4<Ty>& SIMDVector4<Ty>::operator-=(const SIMDVector4<Ty>& right) {
+        idata = Intrin_sub<Ty>(idata, right.idata);
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector4<Ty>& SIMDVector4<Ty>::operator*=(const Ty& right) {
+        idata = Intrin_mul<Ty>(idata, Intrin_set1<Ty>(right));
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector4<Ty>& SIMDVector4<Ty>::operator/=(const Ty& right) {
+        idata = Intrin_div<Ty>(idata, Intrin_set1<Ty>(right));
+        return *this;
+    }
+    template <typename Ty>
+    const SIMDVector4<Ty> SIMDVector4<Ty>::operator+(const SIMDVector4<Ty>& right) {
+        return Intrin_add<Ty>(idata, right.idata);
+    }
+    template <typename Ty>
+    const SIMDVector4<Ty> SIMDVector4<Ty>::operator-(const SIMDVector4<Ty>& right) {
+        return Intrin_sub<Ty>(idata, right.idata);
+    }
+    template <typename Ty>
+    const SIMDVector4<Ty> SIMDVector4<Ty>::operator*(const Ty& right) {
+        return Intrin_mul<Ty>(idata, Intrin_set1<Ty>(right));
+    }
+    template <typename Ty>
+    const SIMDVector4<Ty> SIMDVector4<Ty>::operator/(const Ty& right) {
+        return Intrin_div<Ty>(idata, Intrin_set1<Ty>(right));
+    }
+
+    // Signed magic number and shift (Hacker's Delight 10-1), the loop runs at most 31 times.
+    FMA_INLINE SIMDDivisor4::SIMDDivisor4(int32_t d) : divisor(d) {
+        if (d == 0) throw "Division by zero.";
+        int32_t m = 0, s = 0, add = d > 0 ? 1 : -1, fix = 0;
+        if (d != 1 && d != -1) {
+            const uint32_t two31 = 0x8000'0000u;
+            const uint32_t ad  = d > 0 ? static_cast<uint32_t>(d) : 0u - static_cast<uint32_t>(d);
+            const uint32_t t   = two31 + (static_cast<uint32_t>(d) >> 31);
+            const uint32_t anc = t - 1 - t % ad;
+            uint32_t q1 = two31 / anc, r1 = two31 - q1 * anc;
+            uint32_t q2 = two31 / ad,  r2 = two31 - q2 * ad;
+            uint32_t delta;
+            int32_t  p = 31;
+            do {
+                ++p;
+                q1 *= 2; r1 *= 2; if (r1 >= anc) { ++q1; r1 -= anc; }
+                q2 *= 2; r2 *= 2; if (r2 >= ad)  { ++q2; r2 -= ad; }
+                delta = ad - r2;
+            } while (q1 < delta || (q1 == delta && r1 == 0));
+            m   = static_cast<int32_t>(d > 0 ? q2 + 1 : 0u - (q2 + 1));
+            s   = p - 32;
+            // n is added back when the magic number overflowed into the sign bit.
+            add = (d > 0 && m < 0) ? 1 : (d < 0 && m > 0) ? -1 : 0;
+            fix = -1;
+        }
+        magic = _mm_set1_epi32(m);
+        shift = _mm_cvtsi32_si128(s);
+        addn  = _mm_set1_epi32(add != 0 ? -1 : 0);
+        negn  = _mm_set1_epi32(add < 0 ? -1 : 0);
+        round = _mm_set1_epi32(fix);
+    }
+    FMA_INLINE __m128i SIMDDivisor4::divide(__m128i n) const {
+        __m128i q = Intrin_mulhi(n, magic);
+        __m128i a = _mm_and_si128(n, addn);
+        q = _mm_add_epi32(q, _mm_sub_epi32(_mm_xor_si128(a, negn), negn));
+        q = _mm_sra_epi32(q, shift);
+        // Toward zero: +1 for negative quotients.
+        return _mm_add_epi32(q, _mm_and_si128(_mm_srli_epi32(q, 31), round));
+    }
+    FMA_INLINE int32_t SIMDDivisor4::divide(int32_t n) const {
+        return _mm_cvtsi128_si32(divide(_mm_set1_epi32(n)));
+    }
+    FMA_INLINE const SIMDVector4<int> operator/(const SIMDVector4<int>& a, const SIMDDivisor4& d) {
+        return d.divide(a.idata);
+    }
+    FMA_INLINE SIMDVector4<int>& operator/=(SIMDVector4<int>& a, const SIMDDivisor4& d) {
+        a.idata = d.divide(a.idata);
+        return a;
+    }
+
+    // Functions.
+    template <typename Ty> const SIMDVector4<Ty> operator+(const SIMDVector4<Ty>& a) {
+        return a;
+    }
+    template <typename Ty> const SIMDVector4<Ty> operator-(const SIMDVector4<Ty>& a) {
+        return Intrin_sub<Ty>(Intrin_set1<Ty>(0), a.idata);
+    }
+    template <typename Ty> const Ty              dot(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return Intrin_dot<Ty>(a.idata, b.idata);
+    }
+    template <typename Ty> const Ty              length(const SIMDVector4<Ty>& a) {
+        auto k = Intrin_dotv<Ty>(a.idata, a.idata);
+        return _mm_cvtss_f32(_mm_sqrt_ss(k));
+    }
+    template <typename Ty> const SIMDVector4<Ty> norm(const SIMDVector4<Ty>& a) {
+        auto k = Intrin_dotv<Ty>(a.idata, a.idata);
+        return Intrin_mul<Ty>(a.idata, Intrin_rsqrt(k));
+    }
+    template <typename Ty> const SIMDMask4       operator< (const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return Intrin_cmplt<Ty>(a.idata, b.idata);
+    }
+    template <typename Ty> const SIMDMask4       operator<=(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return Intrin_cmple<Ty>(a.idata, b.idata);
+    }
+    template <typename Ty> const SIMDMask4       operator> (const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return Intrin_cmplt<Ty>(b.idata, a.idata);
+    }
+    template <typename Ty> const SIMDMask4       operator>=(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return Intrin_cmple<Ty>(b.idata, a.idata);
+    }
+    template <typename Ty> const SIMDMask4       operator!=(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return Intrin_cmpneq<Ty>(a.idata, b.idata);
+    }
+    template <typename Ty> const SIMDMask4       equal(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return Intrin_cmpeq<Ty>(a.idata, b.idata);
+    }
+    template <typename Ty> const SIMDVector4<Ty> select(const SIMDMask4& m, const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return simd::Intrin_select(m.idata, a.idata, b.idata);
+    }
+    template <typename Ty> const SIMDVector4<Ty> min(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return Intrin_min<Ty>(a.idata, b.idata);
+    }
+    template <typename Ty> const SIMDVector4<Ty> max(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        return Intrin_max<Ty>(a.idata, b.idata);
+    }
+    template <typename Ty> const SIMDVector4<Ty> clamp(const SIMDVector4<Ty>& x, const SIMDVector4<Ty>& lo, const SIMDVector4<Ty>& hi) {
+        return Intrin_min<Ty>(Intrin_max<Ty>(x.idata, lo.idata), hi.idata);
+    }
+    template <typename Ty> const Ty              hsum(const SIMDVector4<Ty>& a) {
+        auto c = Intrin_add<Ty>(a.idata, Intrin_shuffle<Ty, 0xb1>(a.idata));
+        return Intrin_first<Ty>(Intrin_add<Ty>(c, Intrin_shuffle<Ty, 0x4e>(c)));
+    }
+    template <typename Ty> const Ty              hmin(const SIMDVector4<Ty>& a) {
+        auto c = Intrin_min<Ty>(a.idata, Intrin_shuffle<Ty, 0xb1>(a.idata));
+        return Intrin_first<Ty>(Intrin_min<Ty>(c, Intrin_shuffle<Ty, 0x4e>(c)));
+    }
+    template <typename Ty> const Ty              hmax(const SIMDVector4<Ty>& a) {
+        auto c = Intrin_max<Ty>(a.idata, Intrin_shuffle<Ty, 0xb1>(a.idata));
+        return Intrin_first<Ty>(Intrin_max<Ty>(c, Intrin_shuffle<Ty, 0x4e>(c)));
+    }
+    template <typename Ty>
+    const bool operator==(const SIMDVector4<Ty>& a, const SIMDVector4<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, int>)
+            return _mm_movemask_epi8(_mm_cmpeq_epi32(a.idata, b.idata)) == 0xffff;
+        else if constexpr (std::is_same_v<Ty, float>)
+            return _mm_movemask_ps(_mm_cmpeq_ps(a.idata, b.idata)) == 0xf;
+    }
+    // a * b.yzx - a.yzx * b is the cross product rotated by one lane, one more shuffle puts it back.
+    FMA_INLINE const SIMDVector4<float> cross(const SIMDVector4<float>& a, const SIMDVector4<float>& b) {
+        __m128 c = _mm_sub_ps(_mm_mul_ps(a.idata, b.yzxw().idata), _mm_mul_ps(a.yzxw().idata, b.idata));
+        return _mm_shuffle_ps(c, c, (Swizzle_imm<1, 2, 0, 3>));
+    }
+    FMA_INLINE void sincos(const SIMDVector4<float>& x, SIMDVector4<float>& s, SIMDVector4<float>& c) {
+        simd::sincos(x.idata, s.idata, c.idata);
+    }
+    FMA_INLINE const SIMDVector4<float> sin(const SIMDVector4<float>& x) {
+        return simd::sin(x.idata);
+    }
+    FMA_INLINE const SIMDVector4<float> cos(const SIMDVector4<float>& x) {
+        return simd::cos(x.idata);
+    }
+    FMA_INLINE const SIMDVector4<float> exp(const SIMDVector4<float>& x) {
+        return simd::exp(x.idata);
+    }
+    FMA_INLINE const SIMDVector4<float> log(const SIMDVector4<float>& x) {
+        return simd::log(x.idata);
+    }
+    FMA_INLINE const SIMDVector4<float> sqrt(const SIMDVector4<float>& x) {
+        return _mm_sqrt_ps(x.idata);
+    }
+    FMA_INLINE const SIMDVector4<float> rsqrt(const SIMDVector4<float>& x) {
+        return Intrin_rsqrt(x.idata);
+    }
+    FMA_INLINE const SIMDVector4<float> abs(const SIMDVector4<float>& x) {
+        return simd::abs(x.idata);
+    }
+    FMA_INLINE const SIMDVector4<float> floor(const SIMDVector4<float>& x) {
+        return simd::floor(x.idata);
+    }
+    FMA_INLINE const SIMDVector4<float> round(const SIMDVector4<float>& x) {
+        return simd::round(x.idata);
+    }
+}
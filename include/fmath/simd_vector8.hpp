@@ -0,0 +1,101 @@
+#pragma once
+#include "basic_vector.hpp"
+#include "simd_decl.hpp"
+
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+#define  SIMD_VECTOR8x32 true
+
+namespace force::math {
+
+    // Register for 8 lanes of Ty, see SIMDRegister4.
+    template <typename Ty> struct SIMDRegister8        { using type = __m256i; };
+    template <>            struct SIMDRegister8<float> { using type = __m256; };
+
+    // 8 lane version of SIMDVector4 on AVX2 registers.
+    // Twice the lanes per instruction for packet workloads, same interface.
+    template <typename Ty>
+    class SIMDVector8 {
+    public:
+        using SIMDType = typename SIMDRegister8<Ty>::type;
+        static_assert(std::is_same_v<Ty, float> | std::is_same_v<Ty, int>, "Not uint32 nor float types are not supported!");
+        // Only 4byte types such as int, unsigned int, float support
+        union {
+            alignas(32) Ty                 vdata[8];
+            SIMDType                       idata;
+        };
+
+        using value_type = Ty;
+        using pipe_type  = basic_pipe<Ty, 8>;
+
+        static constexpr std::size_t dimension = 8;
+
+        SIMDVector8();
+        // This constructor is only avalable for simd types.
+        SIMDVector8(SIMDType t);
+        // Missing elements of a short list are zero.
+        SIMDVector8(std::initializer_list<value_type> lst);
+        // pipe constructor can use to do conversions.
+        SIMDVector8(const pipe_type& v);
+        // Trivial copies, the vector travels in one register.
+        SIMDVector8(const SIMDVector8& right)            = default;
+        SIMDVector8(SIMDVector8&& right)                 = default;
+        SIMDVector8& operator=(const SIMDVector8& right) = default;
+        SIMDVector8& operator=(SIMDVector8&& right)      = default;
+        SIMDVector8& operator=(const pipe_type& v);
+        SIMDVector8& operator+=(const SIMDVector8& right);
+        SIMDVector8& operator-=(const SIMDVector8& right);
+        SIMDVector8& operator*=(const value_type& k);
+        SIMDVector8& operator/=(const value_type& k);
+
+        const SIMDVector8     operator+(const SIMDVector8& right) const;
+        const SIMDVector8     operator-(const SIMDVector8& right) const;
+        const SIMDVector8     operator*(const value_type& k) const;
+        const SIMDVector8     operator/(const value_type& k) const;
+
+        value_type&       operator[](size_t i) { return vdata[i]; }
+        const value_type& operator[](size_t i) const { return vdata[i]; }
+        pipe_type         operator*() const { return basic_pipe<Ty, 8>(vdata, 8); }
+
+        // This one can't have simd optimization.
+        template <typename ... Indecies, std::size_t ArgDim = sizeof...(Indecies)>
+        basic_vector<Ty, ArgDim, basic_pipe<Ty, 8>>        operator()(Indecies ... idx) const {
+            basic_vector<Ty, ArgDim, basic_pipe<Ty, 8>>  rVec{};
+            std::initializer_list<std::size_t>  ids = { (std::size_t)idx... };
+            for (std::size_t i = 0; i < ArgDim; ++i) rVec[i] = vdata[*(ids.begin() + i)];
+            return rVec;
+        }
+
+        ~SIMDVector8() = default;
+    };
+
+    template <typename Ty> const SIMDVector8<Ty> operator+ (const SIMDVector8<Ty>& a);
+    template <typename Ty> const SIMDVector8<Ty> operator- (const SIMDVector8<Ty>& a);
+    template <typename Ty> const bool            operator==(const SIMDVector8<Ty>& a, const SIMDVector8<Ty>& b);
+
+    template <typename Ty> const Ty              length(const SIMDVector8<Ty>& a);
+    template <typename Ty> const Ty              dot(const SIMDVector8<Ty>& a, const SIMDVector8<Ty>& b);
+    template <typename Ty> const SIMDVector8<Ty> norm(const SIMDVector8<Ty>& a);
+
+#ifndef FORCE_INLINE_MATH
+    ////////////////////////////////////////////////////////////////////
+    // Instantiated once in simd_vector8.cpp.
+    ////////////////////////////////////////////////////////////////////
+    extern template class SIMDVector8<float>;
+    extern template class SIMDVector8<int>;
+    extern template const SIMDVector8<float> operator+ (const SIMDVector8<float>& a);
+    extern template const SIMDVector8<int>   operator+ (const SIMDVector8<int>& a);
+    extern template const SIMDVector8<float> operator- (const SIMDVector8<float>& a);
+    extern template const SIMDVector8<int>   operator- (const SIMDVector8<int>& a);
+    extern template const bool               operator==(const SIMDVector8<float>& a, const SIMDVector8<float>& b);
+    extern template const bool               operator==(const SIMDVector8<int>& a, const SIMDVector8<int>& b);
+
+    extern template const float              length(const SIMDVector8<float>& a);
+    extern template const float              dot(const SIMDVector8<float>& a, const SIMDVector8<float>& b);
+    extern template const SIMDVector8<float> norm(const SIMDVector8<float>& a);
+#endif
+}
+
+#ifdef FORCE_INLINE_MATH
+#include "simd_vector8.inl"
+#endif
+#endif
@@ -0,0 +1,141 @@
+// Definitions of SIMDVector8 members and functions.
+// Compiled once into force_lib by simd_vector8.cpp, or included by
+// simd_vector8.hpp itself when FORCE_INLINE_MATH is defined.
+#pragma once
+#include "simd_vector8.hpp"
+#include "simd_primary.hpp"
+
+namespace force::math {
+    template <typename Ty>
+    using SIMDType8 = SIMDVector8<Ty>::SIMDType;
+
+    template <typename Ty>
+    inline SIMDType8<Ty> Intrin8_set1(Ty v) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm256_set1_ps(v);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm256_set1_epi32(v);
+    }
+    template <typename Ty>
+    inline SIMDType8<Ty> Intrin8_load(const Ty* const d) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm256_loadu_ps(d);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(d));
+    }
+    template <typename Ty>
+    inline SIMDType8<Ty> Intrin8_add(const SIMDType8<Ty>& a, const SIMDType8<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm256_add_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm256_add_epi32(a, b);
+    }
+    template <typename Ty>
+    inline SIMDType8<Ty> Intrin8_sub(const SIMDType8<Ty>& a, const SIMDType8<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm256_sub_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm256_sub_epi32(a, b);
+    }
+    template <typename Ty>
+    inline SIMDType8<Ty> Intrin8_mul(const SIMDType8<Ty>& a, const SIMDType8<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, float>)    return _mm256_mul_ps(a, b);
+        else if constexpr (std::is_same_v<Ty, int>) return _mm256_mullo_epi32(a, b);
+    }
+    template <typename Ty>
+    inline SIMDType8<Ty> Intrin8_div(const SIMDType8<Ty>& a, Ty k) {
+        if constexpr (std::is_same_v<Ty, float>) return _mm256_div_ps(a, _mm256_set1_ps(k));
+        else if constexpr (std::is_same_v<Ty, int>) {
+            // No integer divide instruction, lane by lane.
+            alignas(32) int v[8];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(v), a);
+            for (int& e : v) e /= k;
+            return _mm256_load_si256(reinterpret_cast<const __m256i*>(v));
+        }
+    }
+    template <typename Ty>
+    inline Ty Intrin8_dot(const SIMDType8<Ty>& a, const SIMDType8<Ty>& b) {
+        static_assert(std::is_same_v<Ty, float>, "Interger vector does not support dot product!");
+
+        if constexpr (std::is_same_v<Ty, float>) {
+            auto c = _mm256_mul_ps(a, b);
+            auto h = _mm_add_ps(_mm256_castps256_ps128(c), _mm256_extractf128_ps(c, 1));
+            auto shuf = _mm_shuffle_ps(h, h, 0xb1);
+            auto sums = _mm_add_ps(h, shuf);
+            shuf = _mm_movehl_ps(shuf, sums);
+            sums = _mm_add_ps(sums, shuf);
+            return _mm_cvtss_f32(sums);
+        }
+    }
+
+    template <typename Ty>
+    SIMDVector8<Ty>::SIMDVector8(SIMDVector8<Ty>::SIMDType t) : idata(t) {}
+
+    template <typename Ty>
+    SIMDVector8<Ty>::SIMDVector8() : idata(Intrin8_set1<Ty>(static_cast<Ty>(0))) {}
+
+    template <typename Ty>
+    SIMDVector8<Ty>::SIMDVector8(std::initializer_list<Ty> lst) : idata(Intrin8_set1<Ty>(static_cast<Ty>(0))) {
+        std::copy(lst.begin(), lst.begin() + std::min<std::size_t>(lst.size(), 8), vdata);
+    }
+    template <typename Ty>
+    SIMDVector8<Ty>::SIMDVector8(const pipe_type& p) : idata(Intrin8_load<Ty>(p.vdata)) {}
+    template <typename Ty>
+    SIMDVector8<Ty>& SIMDVector8<Ty>::operator=(const pipe_type& right) {
+        idata = Intrin8_load<Ty>(right.vdata);
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector8<Ty>& SIMDVector8<Ty>::operator+=(const SIMDVector8<Ty>& right) {
+        idata = Intrin8_add<Ty>(idata, right.idata);
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector8<Ty>& SIMDVector8<Ty>::operator-=(const SIMDVector8<Ty>& right) {
+        idata = Intrin8_sub<Ty>(idata, right.idata);
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector8<Ty>& SIMDVector8<Ty>::operator*=(const Ty& right) {
+        idata = Intrin8_mul<Ty>(idata, Intrin8_set1<Ty>(right));
+        return *this;
+    }
+    template <typename Ty>
+    SIMDVector8<Ty>& SIMDVector8<Ty>::operator/=(const Ty& right) {
+        idata = Intrin8_div<Ty>(idata, right);
+        return *this;
+    }
+    template <typename Ty>
+    const SIMDVector8<Ty> SIMDVector8<Ty>::operator+(const SIMDVector8<Ty>& right) const {
+        return Intrin8_add<Ty>(idata, right.idata);
+    }
+    template <typename Ty>
+    const SIMDVector8<Ty> SIMDVector8<Ty>::operator-(const SIMDVector8<Ty>& right) const {
+        return Intrin8_sub<Ty>(idata, right.idata);
+    }
+    template <typename Ty>
+    const SIMDVector8<Ty> SIMDVector8<Ty>::operator*(const Ty& right) const {
+        return Intrin8_mul<Ty>(idata, Intrin8_set1<Ty>(right));
+    }
+    template <typename Ty>
+    const SIMDVector8<Ty> SIMDVector8<Ty>::operator/(const Ty& right) const {
+        return Intrin8_div<Ty>(idata, right);
+    }
+
+    // Functions.
+    template <typename Ty> const SIMDVector8<Ty> operator+(const SIMDVector8<Ty>& a) {
+        return a;
+    }
+    template <typename Ty> const SIMDVector8<Ty> operator-(const SIMDVector8<Ty>& a) {
+        return Intrin8_sub<Ty>(Intrin8_set1<Ty>(0), a.idata);
+    }
+    template <typename Ty> const Ty              dot(const SIMDVector8<Ty>& a, const SIMDVector8<Ty>& b) {
+        return Intrin8_dot<Ty>(a.idata, b.idata);
+    }
+    template <typename Ty> const Ty              length(const SIMDVector8<Ty>& a) {
+        return sqrt(Intrin8_dot<Ty>(a.idata, a.idata));
+    }
+    template <typename Ty> const SIMDVector8<Ty> norm(const SIMDVector8<Ty>& a) {
+        auto k = rsqrt(Intrin8_dot<Ty>(a.idata, a.idata));
+        return Intrin8_mul<Ty>(a.idata, Intrin8_set1<Ty>(k));
+    }
+    template <typename Ty>
+    const bool operator==(const SIMDVector8<Ty>& a, const SIMDVector8<Ty>& b) {
+        if constexpr (std::is_same_v<Ty, int>)
+            return _mm256_movemask_epi8(_mm256_cmpeq_epi32(a.idata, b.idata)) == -1;
+        else if constexpr (std::is_same_v<Ty, float>)
+            return _mm256_movemask_ps(_mm256_cmp_ps(a.idata, b.idata, _CMP_EQ_OQ)) == 0xff;
+    }
+}
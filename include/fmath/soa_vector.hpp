@@ -0,0 +1,272 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <span>
+#include <utility>
+#include "vector.hpp"
+
+namespace force::math {
+    // Stream entry points of the batch kernels, see primary_batch.hpp.
+    // a, b and y hold one pointer per component, dim is 2 to 4.
+    void Soa_dot   (const float32_t* const* a, const float32_t* const* b, std::size_t dim, float32_t* y, std::size_t n);
+    void Soa_length(const float32_t* const* a, std::size_t dim, float32_t* y, std::size_t n);
+    void Soa_norm  (const float32_t* const* a, std::size_t dim, float32_t* const* y, std::size_t n);
+    void Soa_cross (const float32_t* const* a, const float32_t* const* b, float32_t* const* y, std::size_t n);
+    void Soa_add   (const float32_t* a, const float32_t* b, float32_t* y, std::size_t n);
+    void Soa_scale (const float32_t* a, float32_t k, float32_t* y, std::size_t n);
+
+    template <class Vt> class soa_vector;
+    template <class Vt, bool Const> class soa_reference;
+
+    // One element of a soa_vector, converts to and assigns from the vector
+    // type so code written for basic_vector& keeps working:
+    //
+    //     vec3f v = soa[i];  soa[i] = v;  soa[i][2] += 1.f;  soa[i] *= 2.f;
+    //
+    // It refers into the container, growing the container invalidates it.
+    template <typename Ty, std::size_t Dimension, class VecPipeT, bool Const>
+    class soa_reference<basic_vector<Ty, Dimension, VecPipeT>, Const> {
+    public:
+        using vector_type  = basic_vector<Ty, Dimension, VecPipeT>;
+        using element_type = std::conditional_t<Const, const Ty, Ty>;
+
+        static constexpr std::size_t dimension = Dimension;
+
+        soa_reference(element_type* p, std::size_t stride) : sp(p), sstride(stride) {}
+        soa_reference(const soa_reference&) = default;
+
+        // Copies the elements, a reference is never reseated.
+        soa_reference& operator=(const soa_reference& right) requires (!Const) { return *this = vector_type(right); }
+        soa_reference& operator=(const vector_type& v) requires (!Const) {
+            for (std::size_t k = 0; k < dimension; ++k) (*this)[k] = v[k];
+            return *this;
+        }
+        soa_reference& operator+=(const vector_type& v) requires (!Const) { return *this = vector_type(*this) + v; }
+        soa_reference& operator-=(const vector_type& v) requires (!Const) { return *this = vector_type(*this) - v; }
+        soa_reference& operator*=(const Ty& k) requires (!Const)          { return *this = vector_type(*this) * k; }
+        soa_reference& operator/=(const Ty& k) requires (!Const)          { return *this = vector_type(*this) / k; }
+
+        element_type& operator[](std::size_t k) const { return sp[k * sstride]; }
+        operator vector_type() const {
+            vector_type v;
+            for (std::size_t k = 0; k < dimension; ++k) v[k] = (*this)[k];
+            return v;
+        }
+        vector_type get() const { return *this; }
+
+    private:
+        element_type* sp;
+        std::size_t   sstride;
+    };
+
+    // Structure of arrays: n vectors kept as dimension separate streams
+    // x0 x1 x2 ... | y0 y1 y2 ... | z0 z1 z2 ..., so a register holds the same
+    // component of 4/8/16 vectors and the batch functions below work on all of
+    // them at once, instead of on one basic_vector at a time.
+    // Every stream starts on a 64 byte boundary. Elements are reached through
+    // soa_reference, the streams themselves through stream(k) or x()/y()/z()/w().
+    template <typename Ty, std::size_t Dimension, class VecPipeT>
+    class soa_vector<basic_vector<Ty, Dimension, VecPipeT>> {
+    public:
+        using vector_type     = basic_vector<Ty, Dimension, VecPipeT>;
+        using value_type      = vector_type;
+        using element_type    = Ty;
+        using reference       = soa_reference<vector_type, false>;
+        using const_reference = soa_reference<vector_type, true>;
+
+        static constexpr std::size_t dimension = Dimension;
+        static constexpr std::size_t alignment = 64;
+
+        soa_vector() = default;
+        // n zero vectors.
+        explicit soa_vector(std::size_t n) { resize(n); }
+        soa_vector(std::initializer_list<vector_type> lst) : soa_vector(std::span<const vector_type>(lst.begin(), lst.size())) {}
+        // From an array of structures.
+        explicit soa_vector(std::span<const vector_type> v) {
+            reserve(v.size());
+            for (const vector_type& e : v) push_back(e);
+        }
+        soa_vector(const soa_vector& right) {
+            reserve(right.ssize);
+            ssize = right.ssize;
+            for (std::size_t k = 0; k < dimension; ++k)
+                std::copy(right.stream(k).begin(), right.stream(k).end(), stream(k).begin());
+        }
+        soa_vector(soa_vector&& right) noexcept { swap(right); }
+        soa_vector& operator=(soa_vector right) noexcept {
+            swap(right);
+            return *this;
+        }
+        ~soa_vector() { Free(sdata); }
+
+        std::size_t size()     const { return ssize; }
+        std::size_t capacity() const { return sstride; }
+        bool        empty()    const { return ssize == 0; }
+
+        void reserve(std::size_t n) {
+            if (n <= sstride) return;
+            // Whole cache lines per stream.
+            const std::size_t stride = (n + alignment / sizeof(Ty) - 1) / (alignment / sizeof(Ty)) * (alignment / sizeof(Ty));
+            Ty* p = static_cast<Ty*>(::operator new(stride * dimension * sizeof(Ty), std::align_val_t{ alignment }));
+            for (std::size_t k = 0; k < dimension; ++k)
+                std::copy(sdata + k * sstride, sdata + k * sstride + ssize, p + k * stride);
+            Free(sdata);
+            sdata   = p;
+            sstride = stride;
+        }
+        // New elements are zero.
+        void resize(std::size_t n) {
+            reserve(n);
+            for (std::size_t k = 0; k < dimension; ++k)
+                if (n > ssize) std::fill(sdata + k * sstride + ssize, sdata + k * sstride + n, static_cast<Ty>(0));
+            ssize = n;
+        }
+        void clear() { ssize = 0; }
+        void push_back(const vector_type& v) {
+            if (ssize == sstride) reserve(std::max<std::size_t>(2 * sstride, 1));
+            ++ssize;
+            back() = v;
+        }
+        void pop_back() { --ssize; }
+        void swap(soa_vector& right) noexcept {
+            std::swap(sdata, right.sdata);
+            std::swap(ssize, right.ssize);
+            std::swap(sstride, right.sstride);
+        }
+
+        reference       operator[](std::size_t i)       { return { sdata + i, sstride }; }
+        const_reference operator[](std::size_t i) const { return { sdata + i, sstride }; }
+        reference       back()                          { return (*this)[ssize - 1]; }
+        const_reference back()                    const { return (*this)[ssize - 1]; }
+
+        // Component k of every element.
+        std::span<Ty>       stream(std::size_t k)       { return { sdata + k * sstride, ssize }; }
+        std::span<const Ty> stream(std::size_t k) const { return { sdata + k * sstride, ssize }; }
+        std::span<Ty>       x()       { return stream(0); }
+        std::span<const Ty> x() const { return stream(0); }
+        std::span<Ty>       y()       { return stream(1); }
+        std::span<const Ty> y() const { return stream(1); }
+        std::span<Ty>       z()       requires (Dimension > 2) { return stream(2); }
+        std::span<const Ty> z() const requires (Dimension > 2) { return stream(2); }
+        std::span<Ty>       w()       requires (Dimension > 3) { return stream(3); }
+        std::span<const Ty> w() const requires (Dimension > 3) { return stream(3); }
+
+        // Index based, yields soa_reference like operator[].
+        template <bool Const>
+        class basic_iterator {
+        public:
+            using container = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+            basic_iterator(container* c, std::size_t i) : ic(c), ii(i) {}
+            auto             operator*()  const { return (*ic)[ii]; }
+            basic_iterator&  operator++()       { ++ii; return *this; }
+            basic_iterator   operator++(int)    { basic_iterator t(*this); ++ii; return t; }
+            bool operator==(const basic_iterator& right) const { return ii == right.ii; }
+            bool operator!=(const basic_iterator& right) const { return ii != right.ii; }
+
+        private:
+            container*  ic;
+            std::size_t ii;
+        };
+        using iterator       = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        iterator       begin()       { return { this, 0 }; }
+        iterator       end()         { return { this, ssize }; }
+        const_iterator begin() const { return { this, 0 }; }
+        const_iterator end()   const { return { this, ssize }; }
+
+    private:
+        static void Free(Ty* p) { if (p) ::operator delete(p, std::align_val_t{ alignment }); }
+
+        Ty*         sdata   = nullptr;
+        std::size_t ssize   = 0;
+        std::size_t sstride = 0;
+    };
+
+    using soa_vec2f = soa_vector<vec2f>;
+    using soa_vec3f = soa_vector<vec3f>;
+    using soa_vec4f = soa_vector<vec4f>;
+
+    // Per element functions through a reference, same results as on the vector.
+    template <class Vt, bool C1, bool C2>
+    [[nodiscard]] auto dot(const soa_reference<Vt, C1>& a, const soa_reference<Vt, C2>& b) { return dot(Vt(a), Vt(b)); }
+    template <class Vt, bool C>
+    [[nodiscard]] auto dot(const soa_reference<Vt, C>& a, const Vt& b) { return dot(Vt(a), b); }
+    template <class Vt, bool C>
+    [[nodiscard]] auto dot(const Vt& a, const soa_reference<Vt, C>& b) { return dot(a, Vt(b)); }
+    template <class Vt, bool C>
+    [[nodiscard]] auto length(const soa_reference<Vt, C>& a) { return length(Vt(a)); }
+    template <class Vt, bool C>
+    [[nodiscard]] Vt norm(const soa_reference<Vt, C>& a) { return norm(Vt(a)); }
+    template <class Vt, bool C1, bool C2>
+    [[nodiscard]] Vt cross(const soa_reference<Vt, C1>& a, const soa_reference<Vt, C2>& b) { return cross(Vt(a), Vt(b)); }
+
+    ///////////////////////////////////////////////////////////
+    // Batch geometry
+    // One vector per lane, 4/8/16 at a time like the batch functions in
+    // primary.hpp (and picked at run time the same way). float32_t only.
+    // Only min of the sizes involved are written, y may be a or b.
+    ///////////////////////////////////////////////////////////
+    template <std::size_t Dimension, class VecPipeT>
+    void Soa_streams(const soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& v, const float32_t* (&p)[Dimension]) {
+        for (std::size_t k = 0; k < Dimension; ++k) p[k] = v.stream(k).data();
+    }
+    template <std::size_t Dimension, class VecPipeT>
+    void Soa_streams(soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& v, float32_t* (&p)[Dimension]) {
+        for (std::size_t k = 0; k < Dimension; ++k) p[k] = v.stream(k).data();
+    }
+
+    template <std::size_t Dimension, class VecPipeT>
+    void dot(const soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& a,
+             const soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& b, std::span<float32_t> y) {
+        static_assert(Dimension >= 2 && Dimension <= 4, "Batch geometry needs 2 to 4 dimensions!");
+        const float32_t* pa[Dimension], * pb[Dimension];
+        Soa_streams(a, pa);
+        Soa_streams(b, pb);
+        Soa_dot(pa, pb, Dimension, y.data(), std::min({ a.size(), b.size(), y.size() }));
+    }
+    template <std::size_t Dimension, class VecPipeT>
+    void length(const soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& a, std::span<float32_t> y) {
+        static_assert(Dimension >= 2 && Dimension <= 4, "Batch geometry needs 2 to 4 dimensions!");
+        const float32_t* pa[Dimension];
+        Soa_streams(a, pa);
+        Soa_length(pa, Dimension, y.data(), std::min(a.size(), y.size()));
+    }
+    template <std::size_t Dimension, class VecPipeT>
+    void norm(const soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& a,
+              soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& y) {
+        static_assert(Dimension >= 2 && Dimension <= 4, "Batch geometry needs 2 to 4 dimensions!");
+        const float32_t* pa[Dimension];
+        float32_t*       py[Dimension];
+        Soa_streams(a, pa);
+        Soa_streams(y, py);
+        Soa_norm(pa, Dimension, py, std::min(a.size(), y.size()));
+    }
+    template <class VecPipeT>
+    void cross(const soa_vector<basic_vector<float32_t, 3, VecPipeT>>& a,
+               const soa_vector<basic_vector<float32_t, 3, VecPipeT>>& b,
+               soa_vector<basic_vector<float32_t, 3, VecPipeT>>& y) {
+        const float32_t* pa[3], * pb[3];
+        float32_t*       py[3];
+        Soa_streams(a, pa);
+        Soa_streams(b, pb);
+        Soa_streams(y, py);
+        Soa_cross(pa, pb, py, std::min({ a.size(), b.size(), y.size() }));
+    }
+    template <std::size_t Dimension, class VecPipeT>
+    void add(const soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& a,
+             const soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& b,
+             soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& y) {
+        const std::size_t n = std::min({ a.size(), b.size(), y.size() });
+        for (std::size_t k = 0; k < Dimension; ++k) Soa_add(a.stream(k).data(), b.stream(k).data(), y.stream(k).data(), n);
+    }
+    template <std::size_t Dimension, class VecPipeT>
+    void scale(const soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& a, float32_t k,
+               soa_vector<basic_vector<float32_t, Dimension, VecPipeT>>& y) {
+        const std::size_t n = std::min(a.size(), y.size());
+        for (std::size_t i = 0; i < Dimension; ++i) Soa_scale(a.stream(i).data(), k, y.stream(i).data(), n);
+    }
+}
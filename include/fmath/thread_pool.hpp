@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <type_traits>
+
+namespace force::math {
+    // Built-in pool for the large matrix kernels, see thread_pool.cpp.
+    // One thread per core, started on first use, the caller works too.
+    //
+    // Pool_for runs fn(ctx, begin, end) over [0, n) in chunks of at least
+    // grain elements and returns when all of them are done. A call from
+    // inside a chunk, or while another thread has the pool, runs inline.
+    // If fn throws, chunks not started yet are skipped and the first
+    // exception is rethrown on the caller once the running ones are done.
+    void        Pool_for(std::size_t n, std::size_t grain, void (*fn)(void* ctx, std::size_t begin, std::size_t end), void* ctx);
+    // Threads a Pool_for splits over, the caller included.
+    std::size_t pool_threads();
+
+    // Pool_for for a lambda taking (begin, end), small ranges skip the pool.
+    template <class Fn>
+    void Parallel_for(std::size_t n, std::size_t grain, Fn&& fn) {
+        if (n <= grain) {
+            if (n) fn(std::size_t{ 0 }, n);
+            return;
+        }
+        using F = std::remove_reference_t<Fn>;
+        Pool_for(n, grain, [](void* ctx, std::size_t begin, std::size_t end) { (*static_cast<F*>(ctx))(begin, end); },
+                 const_cast<void*>(static_cast<const void*>(&fn)));
+    }
+}
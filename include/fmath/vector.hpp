@@ -4,6 +4,15 @@
 #if FMA_ARCH & FMA_ARCH_SSE2
 #include "simd_vector4.hpp"
 #endif
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+#include "simd_vector8.hpp"
+#endif
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+#include "simd_vector16.hpp"
+#endif
+#if FMA_ARCH & FMA_ARCH_X86
+#include "simd_packet.hpp"
+#endif
 namespace force::math {
     // Using for basic_vectors.
     // These usings can do conversions between.
@@ -20,4 +29,43 @@ namespace force::math {
     using vec2i = typename basic_vector<int32_t, 2, pipe4i>;
     using vec1f = typename basic_vector<float32_t, 1, pipe4f>;
     using vec1i = typename basic_vector<int32_t, 1, pipe4f>;
+
+    // 16 bit storage vectors, half the size of vec3f/vec4f in arrays.
+    // No math on them, widen to float for that (see half.hpp).
+    using vec4h  = typename basic_vector<float16_t, 4, pipe4h>;
+    using vec3h  = typename basic_vector<float16_t, 3, pipe4h>;
+    using vec4bf = typename basic_vector<bfloat16_t, 4, pipe4bf>;
+    using vec3bf = typename basic_vector<bfloat16_t, 3, pipe4bf>;
+
+    static_assert(Plain_value<vec4f> && Plain_value<vec3f> && Plain_value<vec2f> && Plain_value<vec4i> &&
+                  Plain_value<vec3i> && Plain_value<vec4h> && Plain_value<vec3bf>, "Vectors must stay trivially copyable!");
+#if SIMD_VECTOR4x32
+    static_assert(Plain_value<SIMDVector4<float>> && Plain_value<SIMDVector4<int>>, "Vectors must stay trivially copyable!");
+#endif
+#if FMA_ARCH & FMA_ARCH_X86
+    static_assert(Plain_value<basic_vector<float32_t, 4, pipe4f>> && Plain_value<vec3x4>, "Vectors must stay trivially copyable!");
+#endif
+
+    // Whole arrays of storage vectors, through the bulk kernels of half.hpp.
+    // Only min(from.size(), to.size()) vectors are converted.
+    template <typename Hy, typename Fy>
+    void Vector_widen(std::span<const Hy> from, std::span<Fy> to) {
+        static_assert(sizeof(Hy) == Hy::dimension * sizeof(typename Hy::value_type) && sizeof(Fy) == Fy::dimension * sizeof(float32_t));
+        std::size_t n = std::min(from.size(), to.size()) * Hy::dimension;
+        widen(std::span(reinterpret_cast<const typename Hy::value_type*>(from.data()), n), std::span(reinterpret_cast<float32_t*>(to.data()), n));
+    }
+    template <typename Fy, typename Hy>
+    void Vector_narrow(std::span<const Fy> from, std::span<Hy> to) {
+        static_assert(sizeof(Hy) == Hy::dimension * sizeof(typename Hy::value_type) && sizeof(Fy) == Fy::dimension * sizeof(float32_t));
+        std::size_t n = std::min(from.size(), to.size()) * Hy::dimension;
+        narrow(std::span(reinterpret_cast<const float32_t*>(from.data()), n), std::span(reinterpret_cast<typename Hy::value_type*>(to.data()), n));
+    }
+    inline void widen (std::span<const vec4h>  from, std::span<vec4f>  to) { Vector_widen(from, to); }
+    inline void widen (std::span<const vec3h>  from, std::span<vec3f>  to) { Vector_widen(from, to); }
+    inline void widen (std::span<const vec4bf> from, std::span<vec4f>  to) { Vector_widen(from, to); }
+    inline void widen (std::span<const vec3bf> from, std::span<vec3f>  to) { Vector_widen(from, to); }
+    inline void narrow(std::span<const vec4f>  from, std::span<vec4h>  to) { Vector_narrow(from, to); }
+    inline void narrow(std::span<const vec3f>  from, std::span<vec3h>  to) { Vector_narrow(from, to); }
+    inline void narrow(std::span<const vec4f>  from, std::span<vec4bf> to) { Vector_narrow(from, to); }
+    inline void narrow(std::span<const vec3f>  from, std::span<vec3bf> to) { Vector_narrow(from, to); }
 }
\ No newline at end of file
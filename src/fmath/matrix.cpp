@@ -0,0 +1,49 @@
+#include <algorithm>
+
+#include "primary_batch.hpp"
+#include <fmath/matrix.hpp>
+
+namespace force::math {
+    // basic_matrix.hpp and dynamic_matrix.hpp, large float products.
+    void Mat_gemm(const float32_t* a, std::size_t lda, const float32_t* b, std::size_t ldb,
+                  float32_t* c, std::size_t ldc, std::size_t m, std::size_t k, std::size_t n) {
+        Batch().gemm(a, lda, b, ldb, c, ldc, m, k, n);
+    }
+    void Mat_gemv(const float32_t* a, const float32_t* x, float32_t* y, std::size_t m, std::size_t n) {
+        Batch().gemv(a, x, y, m, n);
+    }
+
+    // Arrays of matrices as packed floats, the scalar table has no matrix
+    // kernels so that build goes one matrix at a time.
+#if FMA_ARCH & FMA_ARCH_X86
+#define MAT_BATCH(kernel, fn) \
+    Batch().kernel(reinterpret_cast<const float32_t*>(m.data()), reinterpret_cast<float32_t*>(to.data()), std::min(m.size(), to.size()))
+#else
+#define MAT_BATCH(kernel, fn) \
+    for (std::size_t i = 0, n = std::min(m.size(), to.size()); i < n; ++i) to[i] = fn(m[i])
+#endif
+
+    void inverse(std::span<const mat4x4f> m, std::span<mat4x4f> to) {
+        MAT_BATCH(mat4_inverse, inverse);
+    }
+    void inverse(std::span<const mat3x3f> m, std::span<mat3x3f> to) {
+        MAT_BATCH(mat3_inverse, inverse);
+    }
+    // Rows of a mat4x4f fill a register each and this math is short, so one
+    // matrix at a time beats turning them into lanes.
+    void affine_inverse(std::span<const mat4x4f> m, std::span<mat4x4f> to) {
+        const std::size_t n = std::min(m.size(), to.size());
+        for (std::size_t i = 0; i < n; ++i) to[i] = affine_inverse(m[i]);
+    }
+    void affine_inverse(std::span<const mat3x3f> m, std::span<mat3x3f> to) {
+        MAT_BATCH(mat3_affine_inverse, affine_inverse);
+    }
+    void determinant(std::span<const mat4x4f> m, std::span<float32_t> to) {
+        MAT_BATCH(mat4_determinant, determinant);
+    }
+    void determinant(std::span<const mat3x3f> m, std::span<float32_t> to) {
+        MAT_BATCH(mat3_determinant, determinant);
+    }
+
+#undef MAT_BATCH
+}
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <atomic>
+
+#include "primary_batch.hpp"
+
+#if FMA_ARCH & FMA_ARCH_X86
+#if FMA_COMPILER & FMA_COMPILER_VC
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace force::math {
+#if FMA_ARCH & FMA_ARCH_X86
+    // Baseline table, whatever FMA_ARCH this file is built at (sse2 by default).
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+    constexpr Batch_table Batch_base = simd::Batch_make(isa::avx512);
+#elif FMA_ARCH & FMA_ARCH_AVX2_BIT
+    constexpr Batch_table Batch_base = simd::Batch_make(isa::avx2);
+#else
+    constexpr Batch_table Batch_base = simd::Batch_make(isa::sse2);
+#endif
+
+    // cpuid leaf/subleaf into r = { eax, ebx, ecx, edx }.
+    inline void Cpuid(unsigned leaf, unsigned sub, unsigned r[4]) {
+#if FMA_COMPILER & FMA_COMPILER_VC
+        int v[4];
+        __cpuidex(v, static_cast<int>(leaf), static_cast<int>(sub));
+        for (int i = 0; i < 4; ++i) r[i] = static_cast<unsigned>(v[i]);
+#else
+        r[0] = r[1] = r[2] = r[3] = 0;
+        __get_cpuid_count(leaf, sub, &r[0], &r[1], &r[2], &r[3]);
+#endif
+    }
+    // Register state the os saves on context switch (xgetbv 0).
+    inline unsigned long long Xgetbv() {
+#if FMA_COMPILER & FMA_COMPILER_VC
+        return _xgetbv(0);
+#else
+        unsigned lo, hi;
+        __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+        return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+    }
+    isa Cpu_isa() {
+        unsigned r[4];
+        Cpuid(0, 0, r);
+        const unsigned top = r[0];
+        Cpuid(1, 0, r);
+        const bool fma     = r[2] & (1u << 12);
+        const bool osxsave = r[2] & (1u << 27);
+        const bool avx     = r[2] & (1u << 28);
+        const bool f16c    = r[2] & (1u << 29);
+        if (!osxsave || !avx || top < 7) return isa::sse2;
+
+        const unsigned long long xcr0 = Xgetbv();
+        Cpuid(7, 0, r);
+        const bool avx2    = r[1] & (1u << 5);
+        const bool avx512f = r[1] & (1u << 16);
+        // xmm/ymm state, then opmask and both zmm halves.
+        if ((xcr0 & 0x06) != 0x06 || !avx2 || !fma || !f16c) return isa::sse2;
+        if ((xcr0 & 0xe6) != 0xe6 || !avx512f)      return isa::avx2;
+        return isa::avx512;
+    }
+    // Best table not above i, the baseline if nothing else fits.
+    const Batch_table* Batch_find(isa i) {
+        const Batch_table* wide[] = { Batch_table_avx512(), Batch_table_avx2() };
+        for (const Batch_table* t : wide)
+            if (t && t->id <= i && t->id > Batch_base.id) return t;
+        return &Batch_base;
+    }
+#else
+    // No simd on this platform, fall back to the scalar functions.
+#define BATCH_UNARY(name) \
+    [](const float32_t* x, float32_t* y, std::size_t n) { for (std::size_t i = 0; i < n; ++i) y[i] = name(x[i]); }
+
+    constexpr Batch_table Batch_base = {
+        .id     = isa::scalar,
+        .sqrt   = BATCH_UNARY(sqrt), .rsqrt = BATCH_UNARY(rsqrt), .cbrt = BATCH_UNARY(cbrt), .log = BATCH_UNARY(log),
+        .exp    = BATCH_UNARY(exp),  .sin   = BATCH_UNARY(sin),   .cos  = BATCH_UNARY(cos),  .tan = BATCH_UNARY(tan),
+        .asin   = BATCH_UNARY(asin), .acos  = BATCH_UNARY(acos),  .atan = BATCH_UNARY(atan),
+        .pow    = [](const float32_t* x, const float32_t* e, float32_t* y, std::size_t n) { for (std::size_t i = 0; i < n; ++i) y[i] = pow(x[i], e[i]); },
+        .atan2  = [](const float32_t* a, const float32_t* b, float32_t* y, std::size_t n) { for (std::size_t i = 0; i < n; ++i) y[i] = atan2(a[i], b[i]); },
+        .pow1   = [](const float32_t* x, float32_t e, float32_t* y, std::size_t n) { for (std::size_t i = 0; i < n; ++i) y[i] = pow(x[i], e); },
+        .sincos = [](const float32_t* x, float32_t* s, float32_t* c, std::size_t n) { for (std::size_t i = 0; i < n; ++i) sincos(x[i], s[i], c[i]); },
+        .half_widen  = [](const uint16_t* h, float32_t* f, std::size_t n) { for (std::size_t i = 0; i < n; ++i) f[i] = Half_float(h[i]); },
+        .bf16_widen  = [](const uint16_t* h, float32_t* f, std::size_t n) { for (std::size_t i = 0; i < n; ++i) f[i] = Bf16_float(h[i]); },
+        .half_narrow = [](const float32_t* f, uint16_t* h, std::size_t n) { for (std::size_t i = 0; i < n; ++i) h[i] = Half_bits(f[i]); },
+        .bf16_narrow = [](const float32_t* f, uint16_t* h, std::size_t n) { for (std::size_t i = 0; i < n; ++i) h[i] = Bf16_bits(f[i]); },
+        .soa_dot = [](const float32_t* const* a, const float32_t* const* b, std::size_t dim, float32_t* y, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                float32_t s = 0;
+                for (std::size_t k = 0; k < dim; ++k) s += a[k][i] * b[k][i];
+                y[i] = s;
+            }
+        },
+        .soa_length = [](const float32_t* const* a, std::size_t dim, float32_t* y, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                float32_t s = 0;
+                for (std::size_t k = 0; k < dim; ++k) s += a[k][i] * a[k][i];
+                y[i] = sqrt(s);
+            }
+        },
+        .soa_norm = [](const float32_t* const* a, std::size_t dim, float32_t* const* y, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                float32_t s = 0;
+                for (std::size_t k = 0; k < dim; ++k) s += a[k][i] * a[k][i];
+                s = rsqrt(s);
+                for (std::size_t k = 0; k < dim; ++k) y[k][i] = a[k][i] * s;
+            }
+        },
+        .soa_cross = [](const float32_t* const* a, const float32_t* const* b, float32_t* const* y, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                float32_t x = a[1][i] * b[2][i] - b[1][i] * a[2][i];
+                float32_t z = a[2][i] * b[0][i] - b[2][i] * a[0][i];
+                float32_t w = a[0][i] * b[1][i] - b[0][i] * a[1][i];
+                y[0][i] = x; y[1][i] = z; y[2][i] = w;
+            }
+        },
+        .add   = [](const float32_t* a, const float32_t* b, float32_t* y, std::size_t n) { for (std::size_t i = 0; i < n; ++i) y[i] = a[i] + b[i]; },
+        .scale = [](const float32_t* x, float32_t k, float32_t* y, std::size_t n) { for (std::size_t i = 0; i < n; ++i) y[i] = x[i] * k; },
+        .gemm = [](const float32_t* a, std::size_t lda, const float32_t* b, std::size_t ldb,
+                   float32_t* c, std::size_t ldc, std::size_t m, std::size_t k, std::size_t n) {
+            for (std::size_t i = 0; i < m; ++i) {
+                for (std::size_t j = 0; j < n; ++j) c[i * ldc + j] = 0;
+                for (std::size_t p = 0; p < k; ++p)
+                    for (std::size_t j = 0; j < n; ++j) c[i * ldc + j] += a[i * lda + p] * b[p * ldb + j];
+            }
+        },
+        .gemv = [](const float32_t* a, const float32_t* x, float32_t* y, std::size_t m, std::size_t n) {
+            for (std::size_t i = 0; i < m; ++i) {
+                float32_t s = 0;
+                for (std::size_t j = 0; j < n; ++j) s += a[i * n + j] * x[j];
+                y[i] = s;
+            }
+        },
+    };
+#undef BATCH_UNARY
+
+    isa Cpu_isa() { return isa::scalar; }
+    const Batch_table* Batch_find(isa) { return &Batch_base; }
+#endif
+
+    // Filled on first use, select_isa() swaps it.
+    std::atomic<const Batch_table*> Batch_active{ nullptr };
+
+    const Batch_table& Batch() {
+        const Batch_table* t = Batch_active.load(std::memory_order_acquire);
+        if (!t) {
+            const Batch_table* best = Batch_find(detected_isa());
+            // Keeps a select_isa() that won the race.
+            t = Batch_active.compare_exchange_strong(t, best, std::memory_order_acq_rel) ? best : t;
+        }
+        return *t;
+    }
+
+    isa detected_isa() {
+        static const isa best = Batch_find(Cpu_isa())->id;
+        return best;
+    }
+    isa active_isa() {
+        return Batch().id;
+    }
+    isa select_isa(isa i) {
+        const Batch_table* t = Batch_find(std::min(i, detected_isa()));
+        Batch_active.store(t, std::memory_order_release);
+        return t->id;
+    }
+
+#define BATCH_UNARY(name)                                                          \
+    void name(std::span<const float32_t> x, std::span<float32_t> y) {              \
+        Batch().name(x.data(), y.data(), std::min(x.size(), y.size()));            \
+    }
+
+    BATCH_UNARY(sqrt)
+    BATCH_UNARY(rsqrt)
+    BATCH_UNARY(cbrt)
+    BATCH_UNARY(log)
+    BATCH_UNARY(exp)
+    BATCH_UNARY(sin)
+    BATCH_UNARY(cos)
+    BATCH_UNARY(tan)
+    BATCH_UNARY(asin)
+    BATCH_UNARY(acos)
+    BATCH_UNARY(atan)
+
+#undef BATCH_UNARY
+
+    void sincos(std::span<const float32_t> x, std::span<float32_t> s, std::span<float32_t> c) {
+        Batch().sincos(x.data(), s.data(), c.data(), std::min({ x.size(), s.size(), c.size() }));
+    }
+    void pow(std::span<const float32_t> x, std::span<const float32_t> n, std::span<float32_t> y) {
+        Batch().pow(x.data(), n.data(), y.data(), std::min({ x.size(), n.size(), y.size() }));
+    }
+    void atan2(std::span<const float32_t> y, std::span<const float32_t> x, std::span<float32_t> a) {
+        Batch().atan2(y.data(), x.data(), a.data(), std::min({ y.size(), x.size(), a.size() }));
+    }
+    void pow(std::span<const float32_t> x, float32_t n, std::span<float32_t> y) {
+        Batch().pow1(x.data(), n, y.data(), std::min(x.size(), y.size()));
+    }
+
+    // half.hpp, both types are a single uint16_t.
+    void widen(std::span<const float16_t> from, std::span<float32_t> to) {
+        Batch().half_widen(reinterpret_cast<const uint16_t*>(from.data()), to.data(), std::min(from.size(), to.size()));
+    }
+    void widen(std::span<const bfloat16_t> from, std::span<float32_t> to) {
+        Batch().bf16_widen(reinterpret_cast<const uint16_t*>(from.data()), to.data(), std::min(from.size(), to.size()));
+    }
+    void narrow(std::span<const float32_t> from, std::span<float16_t> to) {
+        Batch().half_narrow(from.data(), reinterpret_cast<uint16_t*>(to.data()), std::min(from.size(), to.size()));
+    }
+    void narrow(std::span<const float32_t> from, std::span<bfloat16_t> to) {
+        Batch().bf16_narrow(from.data(), reinterpret_cast<uint16_t*>(to.data()), std::min(from.size(), to.size()));
+    }
+}
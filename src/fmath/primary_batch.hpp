@@ -0,0 +1,624 @@
+// Batch kernel tables shared by primary_batch*.cpp, not installed.
+// Every primary_batch_<isa>.cpp includes this at its own FMA_ARCH level and
+// fills one Batch_table, primary_batch.cpp picks one of them at run time.
+#pragma once
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <fmath/half.hpp>
+#include <fmath/primary.hpp>
+#include <fmath/simd_primary.hpp>
+
+namespace force::math {
+    using Batch_unary = void (*)(const float32_t* x, float32_t* y, std::size_t n);
+    using Batch_binary = void (*)(const float32_t* a, const float32_t* b, float32_t* y, std::size_t n);
+    using Batch_pow1  = void (*)(const float32_t* x, float32_t e, float32_t* y, std::size_t n);
+    using Batch_sc    = void (*)(const float32_t* x, float32_t* s, float32_t* c, std::size_t n);
+    using Batch_widen  = void (*)(const uint16_t* h, float32_t* f, std::size_t n);
+    using Batch_narrow = void (*)(const float32_t* f, uint16_t* h, std::size_t n);
+    // soa_vector.hpp, a and b are dim streams (dim is 2 to 4, cross takes 3).
+    using Batch_dot    = void (*)(const float32_t* const* a, const float32_t* const* b, std::size_t dim, float32_t* y, std::size_t n);
+    using Batch_length = void (*)(const float32_t* const* a, std::size_t dim, float32_t* y, std::size_t n);
+    using Batch_norm   = void (*)(const float32_t* const* a, std::size_t dim, float32_t* const* y, std::size_t n);
+    using Batch_cross  = void (*)(const float32_t* const* a, const float32_t* const* b, float32_t* const* y, std::size_t n);
+    // basic_matrix.hpp, c = a * b with a m x k, b k x n, all row after row
+    // (lda, ldb and ldc apart). gemv is y = a * x, a m x n.
+    using Batch_gemm   = void (*)(const float32_t* a, std::size_t lda, const float32_t* b, std::size_t ldb,
+                                  float32_t* c, std::size_t ldc, std::size_t m, std::size_t k, std::size_t n);
+    using Batch_gemv   = void (*)(const float32_t* a, const float32_t* x, float32_t* y, std::size_t m, std::size_t n);
+    // matrix.hpp, the Batch_unary ones named mat* take n packed 4 x 4 (or 3 x 3)
+    // matrices and give n matrices, or n floats for the determinants.
+
+    struct Batch_table {
+        isa         id;
+        Batch_unary  sqrt, rsqrt, cbrt, log, exp, sin, cos, tan, asin, acos, atan;
+        Batch_binary pow, atan2;
+        Batch_pow1   pow1;
+        Batch_sc     sincos;
+        // float16_t and bfloat16_t arrays, see half.hpp.
+        Batch_widen  half_widen, bf16_widen;
+        Batch_narrow half_narrow, bf16_narrow;
+        // Structure of arrays geometry, add and scale work stream by stream.
+        Batch_dot    soa_dot;
+        Batch_length soa_length;
+        Batch_norm   soa_norm;
+        Batch_cross  soa_cross;
+        Batch_binary add;
+        Batch_pow1   scale;
+        Batch_gemm   gemm;
+        Batch_gemv   gemv;
+        // nullptr in the scalar table, matrix.cpp loops over the matrices itself there.
+        Batch_unary  mat4_inverse, mat3_inverse, mat3_affine_inverse, mat4_determinant, mat3_determinant;
+    };
+
+    // Defined in primary_batch_avx2.cpp and primary_batch_avx512.cpp,
+    // nullptr when that file was compiled without the isa enabled.
+    const Batch_table* Batch_table_avx2();
+    const Batch_table* Batch_table_avx512();
+    // Table the batch entry points go through, picked on first use.
+    const Batch_table& Batch();
+
+#if FMA_ARCH & FMA_ARCH_X86
+    namespace simd {
+    inline namespace FMA_SIMD_ABI {
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+        using Batch_lane = lane_of<512>;
+#elif FMA_ARCH & FMA_ARCH_AVX2_BIT
+        using Batch_lane = lane_of<256>;
+#else
+        using Batch_lane = lane_of<128>;
+#endif
+        using Batch_reg  = Batch_lane::type;
+        // Only plain loops below, a std:: algorithm or a scalar function from
+        // another header instantiated here could be picked by the linker for
+        // the baseline code too.
+        template <class T>
+        void Batch_copy(const T* from, T* to, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) to[i] = from[i];
+        }
+
+        // Runs kernel over whole registers, then pads the tail into one more register
+        // so the last few elements take the same path as the others.
+        template <class Kernel>
+        void Batch_apply(const float32_t* x, float32_t* y, std::size_t n, Kernel kernel) {
+            using L = Batch_lane;
+            std::size_t i = 0;
+            for (; i + L::size <= n; i += L::size)
+                L::store(y + i, kernel(L::load(x + i)));
+            if (i < n) {
+                float32_t tail[L::size] = {};
+                Batch_copy(x + i, tail, n - i);
+                L::store(tail, kernel(L::load(tail)));
+                Batch_copy(tail, y + i, n - i);
+            }
+        }
+        template <class Kernel>
+        void Batch_apply(const float32_t* x, const float32_t* z, float32_t* y, std::size_t n, Kernel kernel) {
+            using L = Batch_lane;
+            std::size_t i = 0;
+            for (; i + L::size <= n; i += L::size)
+                L::store(y + i, kernel(L::load(x + i), L::load(z + i)));
+            if (i < n) {
+                float32_t ta[L::size] = {}, tb[L::size] = {};
+                Batch_copy(x + i, ta, n - i);
+                Batch_copy(z + i, tb, n - i);
+                L::store(ta, kernel(L::load(ta), L::load(tb)));
+                Batch_copy(ta, y + i, n - i);
+            }
+        }
+        inline void Batch_sincos(const float32_t* x, float32_t* s, float32_t* c, std::size_t n) {
+            using L = Batch_lane;
+            Batch_reg vs, vc;
+            std::size_t i = 0;
+            for (; i + L::size <= n; i += L::size) {
+                sincos(L::load(x + i), vs, vc);
+                L::store(s + i, vs);
+                L::store(c + i, vc);
+            }
+            if (i < n) {
+                float32_t ts[L::size] = {}, tc[L::size] = {};
+                Batch_copy(x + i, ts, n - i);
+                sincos(L::load(ts), vs, vc);
+                L::store(ts, vs);
+                L::store(tc, vc);
+                Batch_copy(ts, s + i, n - i);
+                Batch_copy(tc, c + i, n - i);
+            }
+        }
+
+        ////////////////////////////////////////////
+        // 16 bit storage, 8 or 16 elements per step.
+        ////////////////////////////////////////////
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+        inline __m512 Half_load (const uint16_t* p)         { return _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+        inline void   Half_store(uint16_t* p, __m512 v)     { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)); }
+        inline __m512 Bf16_load (const uint16_t* p)         { return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))), 16)); }
+        inline void   Bf16_store(uint16_t* p, __m512i r)    { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm512_cvtepi32_epi16(_mm512_srli_epi32(r, 16))); }
+#elif FMA_ARCH & FMA_ARCH_AVX2_BIT
+        inline __m256 Half_load (const uint16_t* p)         { return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+        inline void   Half_store(uint16_t* p, __m256 v)     { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT)); }
+        inline __m256 Bf16_load (const uint16_t* p)         { return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))), 16)); }
+        inline void   Bf16_store(uint16_t* p, __m256i r) {
+            // packus works per 128 bit half, the permute puts both halves low.
+            __m256i h = _mm256_srli_epi32(r, 16);
+            h = _mm256_permute4x64_epi64(_mm256_packus_epi32(h, h), 0xd8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm256_castsi256_si128(h));
+        }
+#else
+        // No half conversion before F16C, float16_t stays scalar here.
+        inline __m128 Bf16_load (const uint16_t* p)         { return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), _mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)))); }
+        inline void   Bf16_store(uint16_t* p, __m128i r) {
+            // srai keeps the top half exact through the signed pack.
+            __m128i h = _mm_srai_epi32(r, 16);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(p), _mm_packs_epi32(h, h));
+        }
+#endif
+        // Bf16_bits for a whole register, the result is in the top 16 bits.
+        inline auto Bf16_round(Batch_reg v) {
+            using L = Batch_lane;
+            auto u = Intrin_bits(v);
+            auto r = Intrin_add(Intrin_add(u, L::set1(0x7fff)), Intrin_and(Intrin_srl<16>(u), L::set1(1)));
+            return Intrin_select(Intrin_cmpeq(v, v), r, Intrin_or(u, L::set1(0x0040'0000)));
+        }
+        inline void Bf16_widen(const uint16_t* h, float32_t* f, std::size_t n) {
+            using L = Batch_lane;
+            std::size_t i = 0;
+            for (; i + L::size <= n; i += L::size) L::store(f + i, Bf16_load(h + i));
+            if (i < n) {
+                uint16_t  th[L::size] = {};
+                float32_t tf[L::size];
+                Batch_copy(h + i, th, n - i);
+                L::store(tf, Bf16_load(th));
+                Batch_copy(tf, f + i, n - i);
+            }
+        }
+        inline void Bf16_narrow(const float32_t* f, uint16_t* h, std::size_t n) {
+            using L = Batch_lane;
+            std::size_t i = 0;
+            for (; i + L::size <= n; i += L::size) Bf16_store(h + i, Bf16_round(L::load(f + i)));
+            if (i < n) {
+                float32_t tf[L::size] = {};
+                uint16_t  th[L::size];
+                Batch_copy(f + i, tf, n - i);
+                Bf16_store(th, Bf16_round(L::load(tf)));
+                Batch_copy(th, h + i, n - i);
+            }
+        }
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+        inline void Half_widen(const uint16_t* h, float32_t* f, std::size_t n) {
+            using L = Batch_lane;
+            std::size_t i = 0;
+            for (; i + L::size <= n; i += L::size) L::store(f + i, Half_load(h + i));
+            if (i < n) {
+                uint16_t  th[L::size] = {};
+                float32_t tf[L::size];
+                Batch_copy(h + i, th, n - i);
+                L::store(tf, Half_load(th));
+                Batch_copy(tf, f + i, n - i);
+            }
+        }
+        inline void Half_narrow(const float32_t* f, uint16_t* h, std::size_t n) {
+            using L = Batch_lane;
+            std::size_t i = 0;
+            for (; i + L::size <= n; i += L::size) Half_store(h + i, L::load(f + i));
+            if (i < n) {
+                float32_t tf[L::size] = {};
+                uint16_t  th[L::size];
+                Batch_copy(f + i, tf, n - i);
+                Half_store(th, L::load(tf));
+                Batch_copy(th, h + i, n - i);
+            }
+        }
+#else
+        inline void Half_widen(const uint16_t* h, float32_t* f, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) f[i] = Half_float(h[i]);
+        }
+        inline void Half_narrow(const float32_t* f, uint16_t* h, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) h[i] = Half_bits(f[i]);
+        }
+#endif
+
+        ////////////////////////////////////////////
+        // Structure of arrays, one lane per vector.
+        ////////////////////////////////////////////
+        // kernel(x, y) over Ni input and No output streams, the tail padded like Batch_apply.
+        template <std::size_t Ni, std::size_t No, class Kernel>
+        void Batch_streams(const float32_t* const* x, float32_t* const* y, std::size_t n, Kernel kernel) {
+            using L = Batch_lane;
+            Batch_reg vx[Ni], vy[No];
+            std::size_t i = 0;
+            for (; i + L::size <= n; i += L::size) {
+                for (std::size_t k = 0; k < Ni; ++k) vx[k] = L::load(x[k] + i);
+                kernel(vx, vy);
+                for (std::size_t k = 0; k < No; ++k) L::store(y[k] + i, vy[k]);
+            }
+            if (i < n) {
+                float32_t t[Ni > No ? Ni : No][L::size] = {};
+                for (std::size_t k = 0; k < Ni; ++k) {
+                    Batch_copy(x[k] + i, t[k], n - i);
+                    vx[k] = L::load(t[k]);
+                }
+                kernel(vx, vy);
+                for (std::size_t k = 0; k < No; ++k) {
+                    L::store(t[k], vy[k]);
+                    Batch_copy(t[k], y[k] + i, n - i);
+                }
+            }
+        }
+        template <std::size_t D>
+        Batch_reg Soa_dot(const Batch_reg* a, const Batch_reg* b) {
+            Batch_reg s = Intrin_mul(a[0], b[0]);
+            for (std::size_t k = 1; k < D; ++k) s = Intrin_add(s, Intrin_mul(a[k], b[k]));
+            return s;
+        }
+        // Dimension as a template argument, so the stream loops above unroll.
+        template <class Fn>
+        void Soa_dim(std::size_t dim, Fn fn) {
+            switch (dim) {
+            case 2:  fn(std::integral_constant<std::size_t, 2>{}); break;
+            case 3:  fn(std::integral_constant<std::size_t, 3>{}); break;
+            default: fn(std::integral_constant<std::size_t, 4>{}); break;
+            }
+        }
+        inline void Soa_dot(const float32_t* const* a, const float32_t* const* b, std::size_t dim, float32_t* y, std::size_t n) {
+            Soa_dim(dim, [&](auto d) {
+                constexpr std::size_t D = decltype(d)::value;
+                const float32_t* x[2 * D];
+                for (std::size_t k = 0; k < D; ++k) x[k] = a[k], x[D + k] = b[k];
+                Batch_streams<2 * D, 1>(x, &y, n, [](const Batch_reg* v, Batch_reg* r) { r[0] = Soa_dot<D>(v, v + D); });
+            });
+        }
+        // Same sqrt as the scalar length.
+        inline void Soa_length(const float32_t* const* a, std::size_t dim, float32_t* y, std::size_t n) {
+            Soa_dim(dim, [&](auto d) {
+                constexpr std::size_t D = decltype(d)::value;
+                Batch_streams<D, 1>(a, &y, n, [](const Batch_reg* v, Batch_reg* r) { r[0] = sqrt(Soa_dot<D>(v, v)); });
+            });
+        }
+        inline void Soa_norm(const float32_t* const* a, std::size_t dim, float32_t* const* y, std::size_t n) {
+            Soa_dim(dim, [&](auto d) {
+                constexpr std::size_t D = decltype(d)::value;
+                Batch_streams<D, D>(a, y, n, [](const Batch_reg* v, Batch_reg* r) {
+                    Batch_reg k = rsqrt(Soa_dot<D>(v, v));
+                    for (std::size_t i = 0; i < D; ++i) r[i] = Intrin_mul(v[i], k);
+                });
+            });
+        }
+        inline void Soa_cross(const float32_t* const* a, const float32_t* const* b, float32_t* const* y, std::size_t n) {
+            const float32_t* x[6] = { a[0], a[1], a[2], b[0], b[1], b[2] };
+            Batch_streams<6, 3>(x, y, n, [](const Batch_reg* v, Batch_reg* r) {
+                r[0] = Intrin_sub(Intrin_mul(v[1], v[5]), Intrin_mul(v[4], v[2]));
+                r[1] = Intrin_sub(Intrin_mul(v[2], v[3]), Intrin_mul(v[5], v[0]));
+                r[2] = Intrin_sub(Intrin_mul(v[0], v[4]), Intrin_mul(v[3], v[1]));
+            });
+        }
+
+        ////////////////////////////////////////////
+        // Blocked GEMM for large float matrices.
+        // B is packed a Gemm_kc x Gemm_nc panel at a time into Gemm_nr wide
+        // slivers and A a Gemm_mc x Gemm_kc block at a time into Gemm_mr high
+        // ones, so the micro kernel reads both front to back and keeps a
+        // Gemm_mr x Gemm_nr tile of C in registers the whole k loop.
+        // Panel of B stays in L2, a sliver of it in L1.
+        ////////////////////////////////////////////
+        constexpr std::size_t Gemm_mr = 6;
+        constexpr std::size_t Gemm_nr = 2 * Batch_lane::size;
+        constexpr std::size_t Gemm_kc = 256;
+        constexpr std::size_t Gemm_mc = 16 * Gemm_mr;
+        constexpr std::size_t Gemm_nc = 512;
+
+        // kc x nc of b (row stride ldb) as nr wide slivers, zero padded.
+        inline void Gemm_pack_b(const float32_t* b, std::size_t ldb, std::size_t kc, std::size_t nc, float32_t* pb) {
+            for (std::size_t j = 0; j < nc; j += Gemm_nr) {
+                const std::size_t nr = nc - j < Gemm_nr ? nc - j : Gemm_nr;
+                for (std::size_t p = 0; p < kc; ++p, pb += Gemm_nr) {
+                    const float32_t* r = b + p * ldb + j;
+                    std::size_t q = 0;
+                    for (; q < nr; ++q)      pb[q] = r[q];
+                    for (; q < Gemm_nr; ++q) pb[q] = 0;
+                }
+            }
+        }
+        // mc x kc of a (row stride lda) as mr high slivers, column after column.
+        inline void Gemm_pack_a(const float32_t* a, std::size_t lda, std::size_t mc, std::size_t kc, float32_t* pa) {
+            for (std::size_t i = 0; i < mc; i += Gemm_mr) {
+                const std::size_t mr = mc - i < Gemm_mr ? mc - i : Gemm_mr;
+                for (std::size_t p = 0; p < kc; ++p, pa += Gemm_mr) {
+                    std::size_t r = 0;
+                    for (; r < mr; ++r)      pa[r] = a[(i + r) * lda + p];
+                    for (; r < Gemm_mr; ++r) pa[r] = 0;
+                }
+            }
+        }
+        // c (mr x nr of it, row stride ldc) = or += the packed slivers' product.
+        // The row loop is a fold over R, so the tile is 2 * Gemm_mr named
+        // registers and not an array in memory.
+        template <std::size_t ... R>
+        void Gemm_micro(std::index_sequence<R...>, std::size_t kc, const float32_t* pa, const float32_t* pb,
+                        float32_t* c, std::size_t ldc, std::size_t mr, std::size_t nr, bool first) {
+            using L = Batch_lane;
+            Batch_reg c0[Gemm_mr] = { (static_cast<void>(R), L::set1(0.f))... };
+            Batch_reg c1[Gemm_mr] = { (static_cast<void>(R), L::set1(0.f))... };
+            for (std::size_t p = 0; p < kc; ++p, pa += Gemm_mr, pb += Gemm_nr) {
+                const Batch_reg b0 = L::load(pb), b1 = L::load(pb + L::size);
+                ((c0[R] = Intrin_fmadd(L::set1(pa[R]), b0, c0[R]),
+                  c1[R] = Intrin_fmadd(L::set1(pa[R]), b1, c1[R])), ...);
+            }
+            // Whole tiles go straight to c, edge tiles through a buffer.
+            if (mr == Gemm_mr && nr == Gemm_nr) {
+                if (!first)
+                    ((c0[R] = Intrin_add(c0[R], L::load(c + R * ldc)),
+                      c1[R] = Intrin_add(c1[R], L::load(c + R * ldc + L::size))), ...);
+                ((L::store(c + R * ldc, c0[R]), L::store(c + R * ldc + L::size, c1[R])), ...);
+                return;
+            }
+            float32_t t[Gemm_mr][Gemm_nr];
+            ((L::store(t[R], c0[R]), L::store(t[R] + L::size, c1[R])), ...);
+            for (std::size_t r = 0; r < mr; ++r, c += ldc)
+                for (std::size_t q = 0; q < nr; ++q) c[q] = first ? t[r][q] : c[q] + t[r][q];
+        }
+        inline void Batch_gemm(const float32_t* a, std::size_t lda, const float32_t* b, std::size_t ldb,
+                               float32_t* c, std::size_t ldc, std::size_t m, std::size_t k, std::size_t n) {
+            if (k == 0) {
+                for (std::size_t i = 0; i < m; ++i)
+                    for (std::size_t j = 0; j < n; ++j) c[i * ldc + j] = 0;
+                return;
+            }
+            float32_t* pa = static_cast<float32_t*>(::operator new(Gemm_mc * Gemm_kc * sizeof(float32_t), std::align_val_t{ 64 }));
+            float32_t* pb = static_cast<float32_t*>(::operator new(Gemm_kc * Gemm_nc * sizeof(float32_t), std::align_val_t{ 64 }));
+            for (std::size_t jc = 0; jc < n; jc += Gemm_nc) {
+                const std::size_t nc = n - jc < Gemm_nc ? n - jc : Gemm_nc;
+                for (std::size_t pc = 0; pc < k; pc += Gemm_kc) {
+                    const std::size_t kc = k - pc < Gemm_kc ? k - pc : Gemm_kc;
+                    Gemm_pack_b(b + pc * ldb + jc, ldb, kc, nc, pb);
+                    for (std::size_t ic = 0; ic < m; ic += Gemm_mc) {
+                        const std::size_t mc = m - ic < Gemm_mc ? m - ic : Gemm_mc;
+                        Gemm_pack_a(a + ic * lda + pc, lda, mc, kc, pa);
+                        for (std::size_t jr = 0; jr < nc; jr += Gemm_nr)
+                            for (std::size_t ir = 0; ir < mc; ir += Gemm_mr)
+                                Gemm_micro(std::make_index_sequence<Gemm_mr>{}, kc, pa + ir * kc, pb + jr * kc, c + (ic + ir) * ldc + jc + jr, ldc,
+                                           mc - ir < Gemm_mr ? mc - ir : Gemm_mr, nc - jr < Gemm_nr ? nc - jr : Gemm_nr, pc == 0);
+                    }
+                }
+            }
+            ::operator delete(pb, std::align_val_t{ 64 });
+            ::operator delete(pa, std::align_val_t{ 64 });
+        }
+        // Four rows per pass share every load of x, each row sums in its own
+        // register and folds it to one float at the end.
+        inline void Batch_gemv(const float32_t* a, const float32_t* x, float32_t* y, std::size_t m, std::size_t n) {
+            using L = Batch_lane;
+            const std::size_t nv = n - n % L::size;
+            std::size_t i = 0;
+            for (; i + 4 <= m; i += 4) {
+                const float32_t* r[4] = { a + i * n, a + (i + 1) * n, a + (i + 2) * n, a + (i + 3) * n };
+                Batch_reg s0 = L::set1(0.f), s1 = s0, s2 = s0, s3 = s0;
+                for (std::size_t j = 0; j < nv; j += L::size) {
+                    const Batch_reg v = L::load(x + j);
+                    s0 = Intrin_fmadd(L::load(r[0] + j), v, s0);
+                    s1 = Intrin_fmadd(L::load(r[1] + j), v, s1);
+                    s2 = Intrin_fmadd(L::load(r[2] + j), v, s2);
+                    s3 = Intrin_fmadd(L::load(r[3] + j), v, s3);
+                }
+                const Batch_reg s[4] = { s0, s1, s2, s3 };
+                for (std::size_t q = 0; q < 4; ++q) {
+                    float32_t t[L::size];
+                    L::store(t, s[q]);
+                    float32_t h = 0;
+                    for (std::size_t l = 0; l < L::size; ++l) h += t[l];
+                    for (std::size_t j = nv; j < n; ++j) h += r[q][j] * x[j];
+                    y[i + q] = h;
+                }
+            }
+            for (; i < m; ++i) {
+                float32_t h = 0;
+                for (std::size_t j = 0; j < n; ++j) h += a[i * n + j] * x[j];
+                y[i] = h;
+            }
+        }
+
+        ////////////////////////////////////////////
+        // Arrays of small matrices, one lane per matrix.
+        // v[D * i + j] holds element (i, j) of L::size matrices, closed form
+        // cofactor expansions then run for all of them at once.
+        ////////////////////////////////////////////
+        // kernel(v, r) on Ni floats per matrix, No floats of each result go back to y.
+        // Four matrices at a time go through 4 x 4 transposes into quarters
+        // of the lane registers (one float left over per 3 x 3 is moved alone),
+        // the tail through zero matrices like Batch_apply pads.
+        template <std::size_t Ni, std::size_t No, class Kernel>
+        void Batch_matrices(const float32_t* m, float32_t* y, std::size_t n, Kernel kernel) {
+            using L = Batch_lane;
+            constexpr std::size_t Q = L::size / 4;
+            constexpr std::size_t Ki = (Ni + 3) / 4 * 4, Ko = (No + 3) / 4 * 4;
+            __m128    q[Ki > Ko ? Ki : Ko][Q];
+            Batch_reg v[Ki], r[Ko];
+            const auto block = [&](const float32_t* x, float32_t* z) {
+                for (std::size_t j = 0; j < Q; ++j) {
+                    const float32_t* p = x + 4 * j * Ni;
+                    for (std::size_t k = 0; k < Ni; k += 4) {
+                        __m128 r0, r1, r2, r3;
+                        if (k + 4 <= Ni) {
+                            r0 = _mm_loadu_ps(p + k);          r1 = _mm_loadu_ps(p + Ni + k);
+                            r2 = _mm_loadu_ps(p + 2 * Ni + k); r3 = _mm_loadu_ps(p + 3 * Ni + k);
+                        } else {
+                            r0 = _mm_load_ss(p + k);          r1 = _mm_load_ss(p + Ni + k);
+                            r2 = _mm_load_ss(p + 2 * Ni + k); r3 = _mm_load_ss(p + 3 * Ni + k);
+                        }
+                        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                        q[k][j] = r0; q[k + 1][j] = r1; q[k + 2][j] = r2; q[k + 3][j] = r3;
+                    }
+                }
+                for (std::size_t k = 0; k < Ni; ++k) v[k] = L::join(q[k]);
+                kernel(v, r);
+                for (std::size_t k = 0; k < No; ++k) L::split(r[k], q[k]);
+                for (std::size_t j = 0; j < Q; ++j) {
+                    float32_t* p = z + 4 * j * No;
+                    for (std::size_t k = 0; k < No; k += 4) {
+                        __m128 r0 = q[k][j], r1 = q[k + 1][j], r2 = q[k + 2][j], r3 = q[k + 3][j];
+                        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                        if (k + 4 <= No) {
+                            _mm_storeu_ps(p + k, r0);          _mm_storeu_ps(p + No + k, r1);
+                            _mm_storeu_ps(p + 2 * No + k, r2); _mm_storeu_ps(p + 3 * No + k, r3);
+                        } else {
+                            _mm_store_ss(p + k, r0);          _mm_store_ss(p + No + k, r1);
+                            _mm_store_ss(p + 2 * No + k, r2); _mm_store_ss(p + 3 * No + k, r3);
+                        }
+                    }
+                }
+            };
+            std::size_t i = 0;
+            for (; i + L::size <= n; i += L::size) block(m + i * Ni, y + i * No);
+            if (i < n) {
+                float32_t x[L::size * Ni] = {}, z[L::size * No];
+                Batch_copy(m + i * Ni, x, (n - i) * Ni);
+                block(x, z);
+                Batch_copy(z, y + i * No, (n - i) * No);
+            }
+        }
+        // a * b - c * d and a * x - b * y + c * z.
+        inline Batch_reg Mat_minor(Batch_reg a, Batch_reg b, Batch_reg c, Batch_reg d) {
+            return Intrin_sub(Intrin_mul(a, b), Intrin_mul(c, d));
+        }
+        inline Batch_reg Mat_cofactor(Batch_reg a, Batch_reg x, Batch_reg b, Batch_reg y, Batch_reg c, Batch_reg z) {
+            return Intrin_add(Intrin_sub(Intrin_mul(a, x), Intrin_mul(b, y)), Intrin_mul(c, z));
+        }
+        // 2 x 2 minors of the top two rows (s) and the bottom two (c),
+        // every cofactor of a 4 x 4 is three of them.
+        inline void Mat4_minors(const Batch_reg* v, Batch_reg* s, Batch_reg* c) {
+            s[0] = Mat_minor(v[0], v[5], v[4], v[1]);
+            s[1] = Mat_minor(v[0], v[6], v[4], v[2]);
+            s[2] = Mat_minor(v[0], v[7], v[4], v[3]);
+            s[3] = Mat_minor(v[1], v[6], v[5], v[2]);
+            s[4] = Mat_minor(v[1], v[7], v[5], v[3]);
+            s[5] = Mat_minor(v[2], v[7], v[6], v[3]);
+            c[0] = Mat_minor(v[8], v[13], v[12], v[9]);
+            c[1] = Mat_minor(v[8], v[14], v[12], v[10]);
+            c[2] = Mat_minor(v[8], v[15], v[12], v[11]);
+            c[3] = Mat_minor(v[9], v[14], v[13], v[10]);
+            c[4] = Mat_minor(v[9], v[15], v[13], v[11]);
+            c[5] = Mat_minor(v[10], v[15], v[14], v[11]);
+        }
+        inline Batch_reg Mat4_det(const Batch_reg* s, const Batch_reg* c) {
+            return Intrin_add(Mat_cofactor(s[0], c[5], s[1], c[4], s[2], c[3]), Mat_cofactor(s[3], c[2], s[4], c[1], s[5], c[0]));
+        }
+        inline void Mat4_inverse(const float32_t* m, float32_t* y, std::size_t n) {
+            Batch_matrices<16, 16>(m, y, n, [](const Batch_reg* v, Batch_reg* r) {
+                Batch_reg s[6], c[6];
+                Mat4_minors(v, s, c);
+                const Batch_reg k  = Intrin_div(Batch_lane::set1(1.f), Mat4_det(s, c));
+                const Batch_reg nk = Intrin_sub(Batch_lane::set1(0.f), k);
+                r[0]  = Intrin_mul(Mat_cofactor(v[5],  c[5], v[6],  c[4], v[7],  c[3]), k);
+                r[1]  = Intrin_mul(Mat_cofactor(v[1],  c[5], v[2],  c[4], v[3],  c[3]), nk);
+                r[2]  = Intrin_mul(Mat_cofactor(v[13], s[5], v[14], s[4], v[15], s[3]), k);
+                r[3]  = Intrin_mul(Mat_cofactor(v[9],  s[5], v[10], s[4], v[11], s[3]), nk);
+                r[4]  = Intrin_mul(Mat_cofactor(v[4],  c[5], v[6],  c[2], v[7],  c[1]), nk);
+                r[5]  = Intrin_mul(Mat_cofactor(v[0],  c[5], v[2],  c[2], v[3],  c[1]), k);
+                r[6]  = Intrin_mul(Mat_cofactor(v[12], s[5], v[14], s[2], v[15], s[1]), nk);
+                r[7]  = Intrin_mul(Mat_cofactor(v[8],  s[5], v[10], s[2], v[11], s[1]), k);
+                r[8]  = Intrin_mul(Mat_cofactor(v[4],  c[4], v[5],  c[2], v[7],  c[0]), k);
+                r[9]  = Intrin_mul(Mat_cofactor(v[0],  c[4], v[1],  c[2], v[3],  c[0]), nk);
+                r[10] = Intrin_mul(Mat_cofactor(v[12], s[4], v[13], s[2], v[15], s[0]), k);
+                r[11] = Intrin_mul(Mat_cofactor(v[8],  s[4], v[9],  s[2], v[11], s[0]), nk);
+                r[12] = Intrin_mul(Mat_cofactor(v[4],  c[3], v[5],  c[1], v[6],  c[0]), nk);
+                r[13] = Intrin_mul(Mat_cofactor(v[0],  c[3], v[1],  c[1], v[2],  c[0]), k);
+                r[14] = Intrin_mul(Mat_cofactor(v[12], s[3], v[13], s[1], v[14], s[0]), nk);
+                r[15] = Intrin_mul(Mat_cofactor(v[8],  s[3], v[9],  s[1], v[10], s[0]), k);
+            });
+        }
+        inline void Mat4_determinant(const float32_t* m, float32_t* y, std::size_t n) {
+            Batch_matrices<16, 1>(m, y, n, [](const Batch_reg* v, Batch_reg* r) {
+                Batch_reg s[6], c[6];
+                Mat4_minors(v, s, c);
+                r[0] = Mat4_det(s, c);
+            });
+        }
+        // Row i of the 3 x 3 inverse times |m| is element i of r1 x r2, r2 x r0 and r0 x r1.
+        inline void Mat3_cofactors(const Batch_reg* v, Batch_reg* c) {
+            c[0] = Mat_minor(v[4], v[8], v[5], v[7]);
+            c[3] = Mat_minor(v[5], v[6], v[3], v[8]);
+            c[6] = Mat_minor(v[3], v[7], v[4], v[6]);
+            c[1] = Mat_minor(v[7], v[2], v[8], v[1]);
+            c[4] = Mat_minor(v[8], v[0], v[6], v[2]);
+            c[7] = Mat_minor(v[6], v[1], v[7], v[0]);
+            c[2] = Mat_minor(v[1], v[5], v[2], v[4]);
+            c[5] = Mat_minor(v[2], v[3], v[0], v[5]);
+            c[8] = Mat_minor(v[0], v[4], v[1], v[3]);
+        }
+        inline Batch_reg Mat3_det(const Batch_reg* v, const Batch_reg* c) {
+            return Intrin_add(Intrin_add(Intrin_mul(v[0], c[0]), Intrin_mul(v[1], c[3])), Intrin_mul(v[2], c[6]));
+        }
+        inline void Mat3_inverse(const float32_t* m, float32_t* y, std::size_t n) {
+            Batch_matrices<9, 9>(m, y, n, [](const Batch_reg* v, Batch_reg* r) {
+                Mat3_cofactors(v, r);
+                const Batch_reg k = Intrin_div(Batch_lane::set1(1.f), Mat3_det(v, r));
+                for (std::size_t i = 0; i < 9; ++i) r[i] = Intrin_mul(r[i], k);
+            });
+        }
+        inline void Mat3_determinant(const float32_t* m, float32_t* y, std::size_t n) {
+            Batch_matrices<9, 1>(m, y, n, [](const Batch_reg* v, Batch_reg* r) {
+                Batch_reg c[9];
+                Mat3_cofactors(v, c);
+                r[0] = Mat3_det(v, c);
+            });
+        }
+        // affine_inverse of basic_matrix.hpp. The 4 x 4 one isn't here, its math
+        // is too short to pay for the transposes (see matrix.cpp).
+        inline void Mat3_affine_inverse(const float32_t* m, float32_t* y, std::size_t n) {
+            Batch_matrices<9, 9>(m, y, n, [](const Batch_reg* v, Batch_reg* r) {
+                using L = Batch_lane;
+                const Batch_reg k0 = Intrin_div(L::set1(1.f), Intrin_add(Intrin_mul(v[0], v[0]), Intrin_mul(v[3], v[3])));
+                const Batch_reg k1 = Intrin_div(L::set1(1.f), Intrin_add(Intrin_mul(v[1], v[1]), Intrin_mul(v[4], v[4])));
+                r[0] = Intrin_mul(v[0], k0); r[1] = Intrin_mul(v[3], k0);
+                r[3] = Intrin_mul(v[1], k1); r[4] = Intrin_mul(v[4], k1);
+                r[2] = Intrin_sub(L::set1(0.f), Intrin_add(Intrin_mul(r[0], v[2]), Intrin_mul(r[1], v[5])));
+                r[5] = Intrin_sub(L::set1(0.f), Intrin_add(Intrin_mul(r[3], v[2]), Intrin_mul(r[4], v[5])));
+                r[6] = r[7] = L::set1(0.f);
+                r[8] = L::set1(1.f);
+            });
+        }
+
+#define BATCH_UNARY(name) \
+        [](const float32_t* x, float32_t* y, std::size_t n) { Batch_apply(x, y, n, [](Batch_reg v) { return name(v); }); }
+
+        // Table of this FMA_ARCH level, id is what it reports as.
+        constexpr Batch_table Batch_make(isa id) {
+            return {
+                .id    = id,
+                .sqrt  = BATCH_UNARY(sqrt),  .rsqrt = BATCH_UNARY(rsqrt), .cbrt = BATCH_UNARY(cbrt), .log  = BATCH_UNARY(log),
+                .exp   = BATCH_UNARY(exp),   .sin   = BATCH_UNARY(sin),   .cos  = BATCH_UNARY(cos),  .tan  = BATCH_UNARY(tan),
+                .asin  = BATCH_UNARY(asin),  .acos  = BATCH_UNARY(acos),  .atan = BATCH_UNARY(atan),
+                .pow   = [](const float32_t* x, const float32_t* e, float32_t* y, std::size_t n) {
+                    Batch_apply(x, e, y, n, [](Batch_reg a, Batch_reg b) { return pow(a, b); });
+                },
+                .atan2 = [](const float32_t* a, const float32_t* b, float32_t* y, std::size_t n) {
+                    Batch_apply(a, b, y, n, [](Batch_reg u, Batch_reg v) { return atan2(u, v); });
+                },
+                .pow1  = [](const float32_t* x, float32_t e, float32_t* y, std::size_t n) {
+                    Batch_reg b = Batch_lane::set1(e);
+                    Batch_apply(x, y, n, [b](Batch_reg a) { return pow(a, b); });
+                },
+                .sincos      = Batch_sincos,
+                .half_widen  = Half_widen,  .bf16_widen  = Bf16_widen,
+                .half_narrow = Half_narrow, .bf16_narrow = Bf16_narrow,
+                .soa_dot     = Soa_dot,     .soa_length  = Soa_length, .soa_norm = Soa_norm, .soa_cross = Soa_cross,
+                .add   = [](const float32_t* a, const float32_t* b, float32_t* y, std::size_t n) {
+                    Batch_apply(a, b, y, n, [](Batch_reg u, Batch_reg v) { return Intrin_add(u, v); });
+                },
+                .scale = [](const float32_t* x, float32_t k, float32_t* y, std::size_t n) {
+                    Batch_reg b = Batch_lane::set1(k);
+                    Batch_apply(x, y, n, [b](Batch_reg a) { return Intrin_mul(a, b); });
+                },
+                .gemm  = Batch_gemm,
+                .gemv  = Batch_gemv,
+                .mat4_inverse     = Mat4_inverse,     .mat3_inverse     = Mat3_inverse, .mat3_affine_inverse = Mat3_affine_inverse,
+                .mat4_determinant = Mat4_determinant, .mat3_determinant = Mat3_determinant,
+            };
+        }
+#undef BATCH_UNARY
+    }
+    }
+#endif
+}
@@ -0,0 +1,16 @@
+// Batch kernels at AVX2, compiled with -mavx2 -mfma -mf16c (/arch:AVX2), see CMakeLists.txt.
+#if defined(__AVX2__) && !defined(FMA_FORCE_PURE)
+#define FMA_FORCE_AVX2
+#endif
+#include "primary_batch.hpp"
+
+namespace force::math {
+    const Batch_table* Batch_table_avx2() {
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+        static constexpr Batch_table table = simd::Batch_make(isa::avx2);
+        return &table;
+#else
+        return nullptr;
+#endif
+    }
+}
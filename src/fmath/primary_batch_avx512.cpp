@@ -0,0 +1,16 @@
+// Batch kernels at AVX-512F, compiled with -mavx512f -mavx2 -mfma -mf16c (/arch:AVX512), see CMakeLists.txt.
+#if defined(__AVX512F__) && !defined(FMA_FORCE_PURE)
+#define FMA_FORCE_AVX512
+#endif
+#include "primary_batch.hpp"
+
+namespace force::math {
+    const Batch_table* Batch_table_avx512() {
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+        static constexpr Batch_table table = simd::Batch_make(isa::avx512);
+        return &table;
+#else
+        return nullptr;
+#endif
+    }
+}
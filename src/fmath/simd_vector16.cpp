@@ -0,0 +1,25 @@
+#include <fmath/simd_vector16.hpp>
+
+// Only with AVX-512 enabled for the whole build, and only once without FORCE_INLINE_MATH.
+#if (FMA_ARCH & FMA_ARCH_AVX512_BIT) && !defined(FORCE_INLINE_MATH)
+#include <fmath/simd_vector16.inl>
+
+#if FMA_COMPILER & FMA_COMPILER_VC
+#pragma warning(disable:4661)
+#endif
+
+namespace force::math {
+    template class SIMDVector16<float>;
+    template class SIMDVector16<int>;
+    template const SIMDVector16<float> operator+ (const SIMDVector16<float>& a);
+    template const SIMDVector16<int>   operator+ (const SIMDVector16<int>& a);
+    template const SIMDVector16<float> operator- (const SIMDVector16<float>& a);
+    template const SIMDVector16<int>   operator- (const SIMDVector16<int>& a);
+    template const bool               operator==(const SIMDVector16<float>& a, const SIMDVector16<float>& b);
+    template const bool               operator==(const SIMDVector16<int>& a, const SIMDVector16<int>& b);
+
+    template const float              length(const SIMDVector16<float>& a);
+    template const float              dot(const SIMDVector16<float>& a, const SIMDVector16<float>& b);
+    template const SIMDVector16<float> norm(const SIMDVector16<float>& a);
+}
+#endif
@@ -0,0 +1,25 @@
+#include <fmath/simd_vector8.hpp>
+
+// Only with AVX2 enabled for the whole build, and only once without FORCE_INLINE_MATH.
+#if (FMA_ARCH & FMA_ARCH_AVX2_BIT) && !defined(FORCE_INLINE_MATH)
+#include <fmath/simd_vector8.inl>
+
+#if FMA_COMPILER & FMA_COMPILER_VC
+#pragma warning(disable:4661)
+#endif
+
+namespace force::math {
+    template class SIMDVector8<float>;
+    template class SIMDVector8<int>;
+    template const SIMDVector8<float> operator+ (const SIMDVector8<float>& a);
+    template const SIMDVector8<int>   operator+ (const SIMDVector8<int>& a);
+    template const SIMDVector8<float> operator- (const SIMDVector8<float>& a);
+    template const SIMDVector8<int>   operator- (const SIMDVector8<int>& a);
+    template const bool               operator==(const SIMDVector8<float>& a, const SIMDVector8<float>& b);
+    template const bool               operator==(const SIMDVector8<int>& a, const SIMDVector8<int>& b);
+
+    template const float              length(const SIMDVector8<float>& a);
+    template const float              dot(const SIMDVector8<float>& a, const SIMDVector8<float>& b);
+    template const SIMDVector8<float> norm(const SIMDVector8<float>& a);
+}
+#endif
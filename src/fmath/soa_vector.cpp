@@ -0,0 +1,24 @@
+#include "primary_batch.hpp"
+#include <fmath/soa_vector.hpp>
+
+namespace force::math {
+    // The soa_vector templates hand over their streams.
+    void Soa_dot(const float32_t* const* a, const float32_t* const* b, std::size_t dim, float32_t* y, std::size_t n) {
+        Batch().soa_dot(a, b, dim, y, n);
+    }
+    void Soa_length(const float32_t* const* a, std::size_t dim, float32_t* y, std::size_t n) {
+        Batch().soa_length(a, dim, y, n);
+    }
+    void Soa_norm(const float32_t* const* a, std::size_t dim, float32_t* const* y, std::size_t n) {
+        Batch().soa_norm(a, dim, y, n);
+    }
+    void Soa_cross(const float32_t* const* a, const float32_t* const* b, float32_t* const* y, std::size_t n) {
+        Batch().soa_cross(a, b, y, n);
+    }
+    void Soa_add(const float32_t* a, const float32_t* b, float32_t* y, std::size_t n) {
+        Batch().add(a, b, y, n);
+    }
+    void Soa_scale(const float32_t* a, float32_t k, float32_t* y, std::size_t n) {
+        Batch().scale(a, k, y, n);
+    }
+}
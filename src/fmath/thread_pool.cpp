@@ -0,0 +1,122 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fmath/thread_pool.hpp>
+
+namespace force::math {
+    namespace {
+        // Set on pool threads and on a caller while it runs a job, nested
+        // Pool_for calls see it and stay on their own thread.
+        thread_local bool In_pool = false;
+
+        class Pool {
+        public:
+            Pool() {
+                const unsigned n = std::max(1u, std::thread::hardware_concurrency());
+                for (unsigned i = 1; i < n; ++i) pworkers.emplace_back([this] { Work(); });
+            }
+            ~Pool() {
+                {
+                    std::lock_guard<std::mutex> l(pmutex);
+                    pstop = true;
+                }
+                pwake.notify_all();
+                for (std::thread& t : pworkers) t.join();
+            }
+
+            std::size_t threads() const { return pworkers.size() + 1; }
+
+            void run(std::size_t n, std::size_t grain, void (*fn)(void*, std::size_t, std::size_t), void* ctx) {
+                std::unique_lock<std::mutex> owner(powner, std::try_to_lock);
+                if (!owner.owns_lock() || pworkers.empty()) return fn(ctx, 0, n);
+                {
+                    std::unique_lock<std::mutex> l(pmutex);
+                    // Threads still leaving the last job read its fields.
+                    pidle.wait(l, [this] { return pbusy == 0; });
+                    // A few chunks per thread, so uneven ones even out.
+                    const std::size_t chunk = std::max(grain, (n + 4 * threads() - 1) / (4 * threads()));
+                    pjob = { fn, ctx, n, chunk };
+                    pnext.store(0, std::memory_order_relaxed);
+                    ++pgeneration;
+                }
+                pwake.notify_all();
+                In_pool = true;
+                Drain(pjob);
+                In_pool = false;
+                std::unique_lock<std::mutex> l(pmutex);
+                pidle.wait(l, [this] { return pbusy == 0; });
+                if (std::exception_ptr e = std::exchange(perror, nullptr)) std::rethrow_exception(e);
+            }
+
+        private:
+            struct Job {
+                void        (*fn)(void*, std::size_t, std::size_t);
+                void*       ctx;
+                std::size_t n, chunk;
+            };
+
+            // A throwing chunk stops the job, the first exception goes back to run().
+            void Drain(const Job& job) {
+                try {
+                    for (;;) {
+                        const std::size_t begin = pnext.fetch_add(job.chunk, std::memory_order_relaxed);
+                        if (begin >= job.n) return;
+                        job.fn(job.ctx, begin, std::min(job.n, begin + job.chunk));
+                    }
+                } catch (...) {
+                    pnext.store(job.n, std::memory_order_relaxed);
+                    std::lock_guard<std::mutex> l(pmutex);
+                    if (!perror) perror = std::current_exception();
+                }
+            }
+            void Work() {
+                In_pool = true;
+                std::size_t seen = 0;
+                for (;;) {
+                    Job job;
+                    {
+                        std::unique_lock<std::mutex> l(pmutex);
+                        pwake.wait(l, [&] { return pstop || pgeneration != seen; });
+                        if (pstop) return;
+                        seen = pgeneration;
+                        job  = pjob;
+                        ++pbusy;
+                    }
+                    Drain(job);
+                    std::lock_guard<std::mutex> l(pmutex);
+                    if (--pbusy == 0) pidle.notify_all();
+                }
+            }
+
+            std::vector<std::thread>  pworkers;
+            std::mutex                powner;
+            std::mutex                pmutex;
+            std::condition_variable   pwake, pidle;
+            Job                       pjob{};
+            std::exception_ptr        perror;
+            std::atomic<std::size_t>  pnext{ 0 };
+            std::size_t               pgeneration = 0;
+            std::size_t               pbusy       = 0;
+            bool                      pstop       = false;
+        };
+
+        Pool& The_pool() {
+            static Pool pool;
+            return pool;
+        }
+    }
+
+    void Pool_for(std::size_t n, std::size_t grain, void (*fn)(void* ctx, std::size_t begin, std::size_t end), void* ctx) {
+        if (In_pool || n <= grain) return fn(ctx, 0, n);
+        The_pool().run(n, grain, fn, ctx);
+    }
+    std::size_t pool_threads() {
+        return The_pool().threads();
+    }
+}
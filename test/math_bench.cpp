@@ -0,0 +1,457 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include <fmath/primary.hpp>
+#include <fmath/simd_vector4.hpp>
+#include <fmath/dynamic_matrix.hpp>
+#include <fmath/matrix.hpp>
+#include <fmath/matrices.hpp>
+#include <fmath/soa_vector.hpp>
+#include <fmath/vector.hpp>
+
+namespace ffm = force::math;
+
+// Runs f a few times and gives back the best ns per element.
+template <typename F>
+double bench(std::size_t n, F&& f) {
+    double best = 1e30;
+    for (int r = 0; r < 7; ++r) {
+        auto t0 = std::chrono::steady_clock::now();
+        f();
+        auto t1 = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(n);
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+volatile float sink;
+
+void report(const char* name, double scalar, double batch) {
+    std::printf("%-28s %8.3f %8.3f %6.2fx\n", name, scalar, batch, scalar / batch);
+}
+
+///////////////////////////////////////////
+// primary.hpp scalar loop vs span batch
+///////////////////////////////////////////
+void bench_primary_batch() {
+    constexpr std::size_t n = 1 << 18;
+    std::vector<float> x(n), y(n);
+    for (std::size_t i = 0; i < n; ++i) x[i] = 0.001f + 10.f * static_cast<float>(i) / n;
+
+#define BENCH_UNARY(fn)                                                                     \
+    report(#fn,                                                                             \
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) y[i] = ffm::fn(x[i]); sink = y[n / 2]; }), \
+        bench(n, [&] { ffm::fn(x, y); sink = y[n / 2]; }));
+
+    std::printf("%-28s %8s %8s %7s\n", "primary (ns/elem)", "scalar", "batch", "gain");
+    BENCH_UNARY(sqrt)
+    BENCH_UNARY(rsqrt)
+    BENCH_UNARY(cbrt)
+    BENCH_UNARY(log)
+    BENCH_UNARY(exp)
+    BENCH_UNARY(sin)
+    BENCH_UNARY(cos)
+    BENCH_UNARY(tan)
+#undef BENCH_UNARY
+    report("pow",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) y[i] = ffm::pow(x[i], 1.5f); sink = y[n / 2]; }),
+        bench(n, [&] { ffm::pow(x, 1.5f, y); sink = y[n / 2]; }));
+
+    // Inverse trig wants [-1, 1].
+    std::vector<float> u(n);
+    for (std::size_t i = 0; i < n; ++i) u[i] = x[i] * 0.1f - 0.5f;
+    report("asin",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) y[i] = ffm::asin(u[i]); sink = y[n / 2]; }),
+        bench(n, [&] { ffm::asin(u, y); sink = y[n / 2]; }));
+    report("acos",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) y[i] = ffm::acos(u[i]); sink = y[n / 2]; }),
+        bench(n, [&] { ffm::acos(u, y); sink = y[n / 2]; }));
+    report("atan",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) y[i] = ffm::atan(x[i]); sink = y[n / 2]; }),
+        bench(n, [&] { ffm::atan(x, y); sink = y[n / 2]; }));
+    report("atan2",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) y[i] = ffm::atan2(u[i], x[i]); sink = y[n / 2]; }),
+        bench(n, [&] { ffm::atan2(u, x, y); sink = y[n / 2]; }));
+
+    std::vector<float> c(n);
+    std::printf("%-28s %8s %8s %7s\n", "sincos (ns/elem)", "sin+cos", "sincos", "gain");
+    report("scalar",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) { y[i] = ffm::sin(x[i]); c[i] = ffm::cos(x[i]); } sink = y[n / 2]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) ffm::sincos(x[i], y[i], c[i]); sink = y[n / 2]; }));
+    report("batch",
+        bench(n, [&] { ffm::sin(x, y); ffm::cos(x, c); sink = y[n / 2]; }),
+        bench(n, [&] { ffm::sincos(x, y, c); sink = y[n / 2]; }));
+
+    // Same span calls forced down to each path the cpu supports.
+    const char* names[] = { "scalar", "sse2", "avx2", "avx512" };
+    const ffm::isa detected = ffm::detected_isa();
+    std::printf("%-28s %8s %8s %7s\n", "batch by isa (ns/elem)", "sin", "exp", "");
+    for (ffm::isa i : { ffm::isa::sse2, ffm::isa::avx2, ffm::isa::avx512 }) {
+        if (i > detected || ffm::select_isa(i) != i) continue;
+        std::printf("%-28s %8.3f %8.3f\n", names[static_cast<int>(i)],
+            bench(n, [&] { ffm::sin(x, y); sink = y[n / 2]; }),
+            bench(n, [&] { ffm::exp(x, y); sink = y[n / 2]; }));
+    }
+    ffm::select_isa(detected);
+}
+
+///////////////////////////////////////////
+// SIMDVector4 operators vs raw intrinsics
+// Without FORCE_INLINE_MATH every operator is a call into force_lib,
+// the raw loop shows what the same work costs once it is inlined.
+///////////////////////////////////////////
+void bench_simd_vector4() {
+    constexpr std::size_t n = 1 << 16;
+    using v4 = ffm::SIMDVector4<float>;
+    std::vector<v4> a(n), b(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        float f = static_cast<float>(i);
+        a[i] = v4{ f, f + 1.f, f + 2.f, f + 3.f };
+        b[i] = v4{ 1.f, 0.5f, 0.25f, 0.125f };
+    }
+#ifdef FORCE_INLINE_MATH
+    std::printf("%-28s %8s %8s %7s\n", "simd_vector4 inline (ns/vec)", "vector", "raw", "ratio");
+#else
+    std::printf("%-28s %8s %8s %7s\n", "simd_vector4 lib (ns/vec)", "vector", "raw", "ratio");
+#endif
+#if FMA_ARCH & FMA_ARCH_X86
+    report("acc += a * k; acc -= b",
+        bench(n, [&] { v4 acc; for (std::size_t i = 0; i < n; ++i) { acc += a[i] * 0.5f; acc -= b[i]; } sink = acc[0]; }),
+        bench(n, [&] {
+            __m128 acc = _mm_setzero_ps(), k = _mm_set1_ps(0.5f);
+            for (std::size_t i = 0; i < n; ++i) acc = _mm_sub_ps(_mm_add_ps(acc, _mm_mul_ps(a[i].idata, k)), b[i].idata);
+            sink = _mm_cvtss_f32(acc); }));
+    report("dot",
+        bench(n, [&] { float acc = 0.f; for (std::size_t i = 0; i < n; ++i) acc += ffm::dot(a[i], b[i]); sink = acc; }),
+        bench(n, [&] {
+            float acc = 0.f;
+            for (std::size_t i = 0; i < n; ++i) {
+                __m128 c = _mm_mul_ps(a[i].idata, b[i].idata);
+                __m128 h = _mm_add_ps(c, _mm_shuffle_ps(c, c, 0xb1));
+                acc += _mm_cvtss_f32(_mm_add_ss(h, _mm_movehl_ps(h, h)));
+            }
+            sink = acc; }));
+    report("norm",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) b[i] = ffm::norm(a[i]); sink = b[n / 2][0]; }),
+        bench(n, [&] {
+            for (std::size_t i = 0; i < n; ++i) {
+                __m128 c = _mm_mul_ps(a[i].idata, a[i].idata);
+                __m128 h = _mm_add_ps(c, _mm_shuffle_ps(c, c, 0xb1));
+                b[i].idata = _mm_mul_ps(a[i].idata, _mm_set1_ps(ffm::rsqrt(_mm_cvtss_f32(_mm_add_ss(h, _mm_movehl_ps(h, h))))));
+            }
+            sink = b[n / 2][0]; }));
+#endif
+}
+
+///////////////////////////////////////////
+// mat4x4f kernels vs the basic_matrix templates
+// Explicit template arguments force the generic triple loops.
+///////////////////////////////////////////
+void bench_mat4x4f() {
+    constexpr std::size_t n = 1 << 12;
+    using mat = ffm::mat4x4f;
+    using vec = ffm::vec4f;
+    std::vector<mat> m(n, mat{}), o(n, mat{});
+    std::vector<vec> v(n), r(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < 16; ++j) m[i].adata[j] = static_cast<float>((i + j) % 7) - 3.f;
+        v[i] = vec{ 1.f, 0.5f, 0.25f, static_cast<float>(i % 5) };
+    }
+    const mat k = m[n / 3];
+
+    std::printf("%-28s %8s %8s %7s\n", "mat4x4f (ns/op)", "generic", "simd", "gain");
+    report("mat * mat",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o[i] = ffm::operator*<float, 4, 4, 4, ffm::pipe4f>(m[i], k); sink = o[n / 2][0][0]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o[i] = m[i] * k; sink = o[n / 2][0][0]; }));
+    report("mat * vec",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = ffm::operator*<float, 4, 4, ffm::pipe4f>(m[i], v[i]); sink = r[n / 2][0]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = m[i] * v[i]; sink = r[n / 2][0]; }));
+    report("vec * mat",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = ffm::operator*<float, 4, 4, ffm::pipe4f>(v[i], m[i]); sink = r[n / 2][0]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = v[i] * m[i]; sink = r[n / 2][0]; }));
+    report("transpose",
+        bench(n, [&] { mat acc = k; for (std::size_t i = 0; i < n; ++i) acc += ffm::transpose<float, 4, 4, ffm::pipe4f>(m[i]); sink = acc[1][0]; }),
+        bench(n, [&] { mat acc = k; for (std::size_t i = 0; i < n; ++i) acc += ffm::transpose(m[i]); sink = acc[1][0]; }));
+}
+
+///////////////////////////////////////////
+// Inverses, generic templates vs simd, then one at a time vs the batch
+///////////////////////////////////////////
+void bench_inverse() {
+    constexpr std::size_t n = 1 << 12;
+    using mat = ffm::mat4x4f;
+    using mat3 = ffm::mat3x3f;
+    std::vector<mat> m(n), o(n);
+    std::vector<mat3> m3(n), o3(n);
+    std::vector<float> d(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const float a = static_cast<float>(i % 13) * 0.1f;
+        m[i]  = ffm::matrices::translate(ffm::vec3f{ a, 1.f, -a }) * ffm::matrices::rotate(a, ffm::vec3f{ 0.f, 0.6f, 0.8f }) * ffm::matrices::scale(ffm::vec3f{ 1.f + a, 2.f, 1.f });
+        m3[i] = ffm::matrices::translate(ffm::vec2f{ a, 1.f }) * ffm::matrices::rotate(a, ffm::vec2f{}) * ffm::matrices::scale(ffm::vec2f{ 1.f + a, 2.f });
+    }
+
+    std::printf("%-28s %8s %8s %7s\n", "inverse (ns/op)", "generic", "simd", "gain");
+    report("mat4x4f inverse",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o[i] = ffm::inverse<float, 4, ffm::pipe4f>(m[i]); sink = o[n / 2][0][0]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o[i] = ffm::inverse(m[i]); sink = o[n / 2][0][0]; }));
+    report("mat4x4f determinant",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) d[i] = ffm::determinant<float, 4, ffm::pipe4f>(m[i]); sink = d[n / 2]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) d[i] = ffm::determinant(m[i]); sink = d[n / 2]; }));
+    report("mat4x4f affine_inverse",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o[i] = ffm::affine_inverse<float, 4, ffm::pipe4f>(m[i]); sink = o[n / 2][0][0]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o[i] = ffm::affine_inverse(m[i]); sink = o[n / 2][0][0]; }));
+    report("mat3x3f inverse",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o3[i] = ffm::inverse<float, 3, ffm::pipe4f>(m3[i]); sink = o3[n / 2][0][0]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o3[i] = ffm::inverse(m3[i]); sink = o3[n / 2][0][0]; }));
+
+    std::printf("%-28s %8s %8s %7s\n", "inverse arrays (ns/op)", "simd", "batch", "gain");
+    report("mat4x4f inverse",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o[i] = ffm::inverse(m[i]); sink = o[n / 2][0][0]; }),
+        bench(n, [&] { ffm::inverse(m, o); sink = o[n / 2][0][0]; }));
+    report("mat4x4f determinant",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) d[i] = ffm::determinant(m[i]); sink = d[n / 2]; }),
+        bench(n, [&] { ffm::determinant(m, d); sink = d[n / 2]; }));
+    report("mat4x4f affine_inverse",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o[i] = ffm::affine_inverse(m[i]); sink = o[n / 2][0][0]; }),
+        bench(n, [&] { ffm::affine_inverse(m, o); sink = o[n / 2][0][0]; }));
+    report("mat3x3f inverse",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o3[i] = ffm::inverse(m3[i]); sink = o3[n / 2][0][0]; }),
+        bench(n, [&] { ffm::inverse(m3, o3); sink = o3[n / 2][0][0]; }));
+    report("mat3x3f affine_inverse",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) o3[i] = ffm::affine_inverse(m3[i]); sink = o3[n / 2][0][0]; }),
+        bench(n, [&] { ffm::affine_inverse(m3, o3); sink = o3[n / 2][0][0]; }));
+}
+
+///////////////////////////////////////////
+// Eager operators vs lazy() expression chains
+// Eager makes a temporary per operator, lazy runs one fused loop.
+///////////////////////////////////////////
+void bench_expression() {
+    constexpr std::size_t n = 1 << 10;
+    using v64 = ffm::basic_vector<float, 64, ffm::basic_pipe<float, 64>>;
+    using ffm::lazy;
+    std::vector<v64> a(n), b(n), c(n), d(n), r(n);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < 64; ++j) {
+            float f = static_cast<float>(i + j);
+            a[i][j] = f; b[i][j] = 0.5f * f; c[i][j] = 1.f; d[i][j] = f - 3.f;
+        }
+
+    std::printf("%-28s %8s %8s %7s\n", "vec64 chain (ns/vec)", "eager", "lazy", "gain");
+    report("a + b * k",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = a[i] + b[i] * 0.5f; sink = r[n / 2][1]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = lazy(a[i]) + lazy(b[i]) * 0.5f; sink = r[n / 2][1]; }));
+    report("a + b * k - c + d / k",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = a[i] + b[i] * 0.5f - c[i] + d[i] / 3.f; sink = r[n / 2][1]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = lazy(a[i]) + lazy(b[i]) * 0.5f - lazy(c[i]) + lazy(d[i]) / 3.f; sink = r[n / 2][1]; }));
+    report("(a - b) * k + (c - d) * k",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = (a[i] - b[i]) * 0.5f + (c[i] - d[i]) * 2.f; sink = r[n / 2][1]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = (lazy(a[i]) - b[i]) * 0.5f + (lazy(c[i]) - d[i]) * 2.f; sink = r[n / 2][1]; }));
+}
+
+///////////////////////////////////////////
+// Array of vec3f vs soa_vec3f batch geometry
+///////////////////////////////////////////
+void bench_soa_vector() {
+    constexpr std::size_t n = 1 << 16;
+    std::vector<ffm::vec3f> a(n), b(n), r(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        float f = static_cast<float>(i);
+        a[i] = { f, 1.f - f, 0.5f * f + 1.f };
+        b[i] = { 2.f, f, f - 3.f };
+    }
+    ffm::soa_vec3f sa{ std::span<const ffm::vec3f>(a) }, sb{ std::span<const ffm::vec3f>(b) }, sr(n);
+    std::vector<float> y(n);
+
+    std::printf("%-28s %8s %8s %7s\n", "vec3f (ns/vec)", "aos", "soa", "gain");
+    report("dot",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) y[i] = ffm::dot(a[i], b[i]); sink = y[n / 2]; }),
+        bench(n, [&] { ffm::dot(sa, sb, std::span(y)); sink = y[n / 2]; }));
+    report("length",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) y[i] = ffm::length(a[i]); sink = y[n / 2]; }),
+        bench(n, [&] { ffm::length(sa, std::span(y)); sink = y[n / 2]; }));
+    report("norm",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = ffm::norm(a[i]); sink = r[n / 2][1]; }),
+        bench(n, [&] { ffm::norm(sa, sr); sink = sr.y()[n / 2]; }));
+    report("cross",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = ffm::cross(a[i], b[i]); sink = r[n / 2][1]; }),
+        bench(n, [&] { ffm::cross(sa, sb, sr); sink = sr.y()[n / 2]; }));
+    report("a + b",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = a[i] + b[i]; sink = r[n / 2][1]; }),
+        bench(n, [&] { ffm::add(sa, sb, sr); sink = sr.y()[n / 2]; }));
+    report("a * k",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r[i] = a[i] * 0.5f; sink = r[n / 2][1]; }),
+        bench(n, [&] { ffm::scale(sa, 0.5f, sr); sink = sr.y()[n / 2]; }));
+}
+
+///////////////////////////////////////////
+// One vec3f at a time vs vec3x4 packets
+// Reflect rays about normals: d - n * 2 dot(d, n), then normalize.
+///////////////////////////////////////////
+void bench_packet() {
+    constexpr std::size_t n = 1 << 16;
+    std::vector<ffm::vec3f> d(n), nv(n), r(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        float f = static_cast<float>(i);
+        d[i]  = { f, 1.f - f, 0.5f * f + 1.f };
+        nv[i] = ffm::norm(ffm::vec3f{ 2.f, f, f - 3.f });
+    }
+
+    std::printf("%-28s %8s %8s %7s\n", "vec3f (ns/vec)", "single", "x4", "gain");
+    report("reflect + norm",
+        bench(n, [&] {
+            for (std::size_t i = 0; i < n; ++i) r[i] = ffm::norm(d[i] - nv[i] * (2.f * ffm::dot(d[i], nv[i])));
+            sink = r[n / 2][1];
+        }),
+        bench(n, [&] {
+            for (std::size_t i = 0; i < n; i += ffm::vec3x4::width) {
+                auto pd = ffm::vec3x4::load(d.data() + i), pn = ffm::vec3x4::load(nv.data() + i);
+                ffm::norm(pd - pn * _mm_add_ps(ffm::dot(pd, pn), ffm::dot(pd, pn))).store(r.data() + i);
+            }
+            sink = r[n / 2][1];
+        }));
+}
+
+///////////////////////////////////////////
+// Copies: user provided copy constructors (fill then copy, as the types
+// used to have) vs the trivially copyable types.
+///////////////////////////////////////////
+struct legacy_vec4f {
+    float vdata[4];
+    legacy_vec4f() { std::fill(vdata, vdata + 4, 0.f); }
+    legacy_vec4f(const legacy_vec4f& right) { std::fill(vdata, vdata + 4, 0.f); std::copy(right.vdata, right.vdata + 4, vdata); }
+    legacy_vec4f& operator=(const legacy_vec4f& right) { std::copy(right.vdata, right.vdata + 4, vdata); return *this; }
+};
+struct legacy_mat4x4f {
+    legacy_vec4f vdata[4];
+    legacy_mat4x4f() = default;
+    legacy_mat4x4f(const legacy_mat4x4f& right) { for (int i = 0; i < 4; ++i) vdata[i] = right.vdata[i]; }
+    legacy_mat4x4f& operator=(const legacy_mat4x4f& right) { for (int i = 0; i < 4; ++i) vdata[i] = right.vdata[i]; return *this; }
+};
+// Out of line so the argument really goes through the calling convention.
+#if FMA_COMPILER & FMA_COMPILER_VC
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+BENCH_NOINLINE float by_value(legacy_vec4f v) { return v.vdata[0] + v.vdata[3]; }
+BENCH_NOINLINE float by_value(ffm::basic_vector<float, 4, ffm::pipe4f> v) { return v.vdata[0] + v.vdata[3]; }
+
+void bench_trivial_copy() {
+    constexpr std::size_t n = 1 << 14;
+    std::vector<legacy_mat4x4f> lm(n);
+    std::vector<ffm::mat4x4f>   tm(n, ffm::mat4x4f{ 1.f });
+    std::vector<legacy_vec4f>   lv(n);
+    std::vector<ffm::basic_vector<float, 4, ffm::pipe4f>> tv(n);
+
+    std::printf("%-28s %8s %8s %7s\n", "copies (ns/elem)", "legacy", "trivial", "gain");
+    report("vec4f by value",
+        bench(n, [&] { float s = 0; for (std::size_t i = 0; i < n; ++i) s += by_value(lv[i]); sink = s; }),
+        bench(n, [&] { float s = 0; for (std::size_t i = 0; i < n; ++i) s += by_value(tv[i]); sink = s; }));
+    report("vector<mat4x4f> copy",
+        bench(n, [&] { std::vector<legacy_mat4x4f> c(lm); sink = c[n / 2].vdata[1].vdata[1]; }),
+        bench(n, [&] { std::vector<ffm::mat4x4f> c(tm); sink = c[n / 2].adata[5]; }));
+    report("vector<mat4x4f> grow",
+        bench(n, [&] { std::vector<legacy_mat4x4f> c(lm); c.reserve(2 * n); sink = c[n / 2].vdata[1].vdata[1]; }),
+        bench(n, [&] { std::vector<ffm::mat4x4f> c(tm); c.reserve(2 * n); sink = c[n / 2].adata[5]; }));
+}
+
+// The copying pipe is what *v gave back before views.
+void bench_pipe_view() {
+    constexpr std::size_t n = 1 << 14;
+    std::vector<ffm::vec3f> p(n, ffm::vec3f{ 1.f, 2.f, 3.f });
+    std::vector<ffm::vec2f> q(n, ffm::vec2f{ 1.f, 2.f });
+    std::vector<ffm::vec4f> h(n, ffm::vec4f{ 1.f, 2.f, 3.f, 1.f });
+    std::vector<ffm::vec4f> r4(n);
+    std::vector<ffm::vec3f> r3(n);
+
+    std::printf("%-28s %8s %8s %7s\n", "conversions (ns/elem)", "pipe", "view", "gain");
+    report("vec3f | 1 -> vec4f",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r4[i] = ffm::pipe4f(p[i].vdata, 3) | 1.f; sink = r4[n / 2][3]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r4[i] = *p[i] | 1.f; sink = r4[n / 2][3]; }));
+    report("vec2f | 0 | 1 -> vec4f",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r4[i] = ffm::pipe4f(q[i].vdata, 2) | 0.f | 1.f; sink = r4[n / 2][3]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r4[i] = *q[i] | 0.f | 1.f; sink = r4[n / 2][3]; }));
+    report("vec4f -> vec3f",
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r3[i] = ffm::vec3f(ffm::pipe4f(h[i].vdata, 4)); sink = r3[n / 2][2]; }),
+        bench(n, [&] { for (std::size_t i = 0; i < n; ++i) r3[i] = ffm::vec3f(*h[i]); sink = r3[n / 2][2]; }));
+}
+
+///////////////////////////////////////////
+// Large matrix products, GFLOP/s
+///////////////////////////////////////////
+// operator* for basic_matrix before the blocked GEMM.
+template <class Mat>
+void legacy_gemm(const Mat& a, const Mat& b, Mat& c) {
+    for (std::size_t i = 0; i < Mat::col; ++i)
+        for (std::size_t j = 0; j < Mat::row; ++j) {
+            float s = 0;
+            for (std::size_t k = 0; k < Mat::row; ++k) s += a[i][k] * b[k][j];
+            c[i][j] = s;
+        }
+}
+template <std::size_t N>
+void bench_gemm_size(const char* name) {
+    using mat = ffm::basic_matrix<float, N, N, ffm::basic_pipe<float, N>>;
+    // Too large for the stack, the product is built in place.
+    std::unique_ptr<mat> a(new mat()), b(new mat()), c(new mat());
+    for (std::size_t i = 0; i < N * N; ++i) {
+        a->adata[i] = static_cast<float>(i % 7) - 3.f;
+        b->adata[i] = static_cast<float>(i % 5) * 0.5f;
+    }
+    const std::size_t flops = 2 * N * N * N;
+    double loop    = bench(flops, [&] { legacy_gemm(*a, *b, *c); sink = c->adata[N]; });
+    double blocked = bench(flops, [&] { new (c.get()) mat(*a * *b); sink = c->adata[N]; });
+    std::printf("%-28s %8.2f %8.2f %6.2fx\n", name, 1. / loop, 1. / blocked, loop / blocked);
+}
+void bench_gemm() {
+    std::printf("%-28s %8s %8s %7s\n", "matrix product (GFLOP/s)", "loop", "blocked", "gain");
+    bench_gemm_size<64>("64 x 64");
+    bench_gemm_size<128>("128 x 128");
+    bench_gemm_size<256>("256 x 256");
+    bench_gemm_size<512>("512 x 512");
+}
+
+///////////////////////////////////////////
+// dynamic_matrix, one thread vs the pool, GFLOP/s
+///////////////////////////////////////////
+void bench_dynamic_size(std::size_t n) {
+    ffm::dynamic_matf a(n, n), b(n, n), c(n, n);
+    ffm::dynamic_vecf x(n), y(n);
+    for (std::size_t i = 0; i < n * n; ++i) {
+        a.data()[i] = static_cast<float>(i % 7) - 3.f;
+        b.data()[i] = static_cast<float>(i % 5) * 0.5f;
+    }
+    // Gain out of pool_threads(), 100% is a perfect split over every thread.
+    const double threads = static_cast<double>(ffm::pool_threads());
+    const std::size_t flops = 2 * n * n * n;
+    double single = bench(flops, [&] { ffm::Mat_gemm(a.data(), n, b.data(), n, c.data(), n, n, n, n); sink = c[1][0]; });
+    double pool   = bench(flops, [&] { ffm::gemm<float>(a, b, c); sink = c[1][0]; });
+    std::printf("gemm %-23zu %8.2f %8.2f %6.2fx %7.0f%%\n", n, 1. / single, 1. / pool, single / pool, 100. * single / pool / threads);
+    single = bench(2 * n * n, [&] { ffm::Mat_gemv(a.data(), x.data(), y.data(), n, n); sink = y[1]; });
+    pool   = bench(2 * n * n, [&] { ffm::gemv<float>(a, x, y); sink = y[1]; });
+    std::printf("gemv %-23zu %8.2f %8.2f %6.2fx %7.0f%%\n", n, 1. / single, 1. / pool, single / pool, 100. * single / pool / threads);
+}
+void bench_dynamic() {
+    std::printf("%-28s %8s %8s %7s %8s (%zu threads)\n", "dynamic_matf (GFLOP/s)", "1 thread", "pool", "gain", "scaling", ffm::pool_threads());
+    bench_dynamic_size(256);
+    bench_dynamic_size(1024);
+    bench_dynamic_size(2048);
+}
+
+int main(int argc, char* argv[]) {
+    bench_primary_batch();
+    bench_simd_vector4();
+    bench_mat4x4f();
+    bench_inverse();
+    bench_expression();
+    bench_soa_vector();
+    bench_packet();
+    bench_trivial_copy();
+    bench_pipe_view();
+    bench_gemm();
+    bench_dynamic();
+}
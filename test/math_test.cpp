@@ -1,13 +1,454 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <climits>
+#include <cmath>
+#include <cstdint>
 #include <iostream>
+#include <random>
+#include <vector>
 
 #include <fmath/primary.hpp>
 #include <fmath/matrices.hpp>
 #include <fmath/complex.hpp>
+#include <fmath/dynamic_matrix.hpp>
+#include <fmath/soa_vector.hpp>
 #include <fmath/math_format.hpp>
 
-int main(int argc, char* argv[]) {
-    namespace ffm = force::math;
+namespace ffm = force::math;
+
+// primary functions fold at compile time.
+constexpr auto sin_table = [] {
+    std::array<float, 16> t{};
+    for (std::size_t i = 0; i < t.size(); ++i) t[i] = ffm::sin(ffm::twopi<float> * i / t.size());
+    return t;
+}();
+static_assert(ffm::abs(sin_table[4] - 1.f) < 1e-5f);
+static_assert(ffm::abs(ffm::sqrt<ffm::precision::precise>(2.f) - ffm::sqrt2<float>) < 1e-6f);
+static_assert(ffm::abs(ffm::exp(1.f) - ffm::e<float>) < 1e-5f);
+static_assert(ffm::abs(ffm::log(ffm::e<float>) - 1.f) < 1e-5f);
+
+// 16 bit storage rounds to nearest even.
+static_assert(static_cast<float>(ffm::float16_t(1.f + 0x1p-11f)) == 1.f);
+static_assert(static_cast<float>(ffm::float16_t(1.f + 0x1p-10f)) == 1.f + 0x1p-10f);
+static_assert(static_cast<float>(ffm::float16_t(65520.f)) == std::numeric_limits<float>::infinity());
+static_assert(static_cast<float>(ffm::float16_t(0x1p-24f)) == 0x1p-24f);
+static_assert(static_cast<float>(ffm::bfloat16_t(1.f + 0x1p-8f)) == 1.f);
+static_assert(static_cast<float>(ffm::bfloat16_t(-3.f)) == -3.f);
+
+// Vectors, matrices and the matrices:: builders fold at compile time.
+constexpr ffm::vec3f basis_z = ffm::cross(ffm::vec3f{ 1.f, 0.f, 0.f }, ffm::vec3f{ 0.f, 1.f, 0.f });
+static_assert(basis_z[0] == 0.f && basis_z[1] == 0.f && basis_z[2] == 1.f);
+static_assert(ffm::dot(ffm::vec4f{ 1.f, 2.f, 3.f, 4.f }, ffm::vec4f{ 4.f, 3.f, 2.f, 1.f }) == 20.f);
+static_assert(ffm::abs(ffm::length(ffm::vec3f{ 3.f, 4.f, 0.f }) - 5.f) < 1e-6f);
+static_assert(ffm::vec4f{ 1.f, 2.f, 3.f, 4.f }.wzyx() == ffm::vec4f{ 4.f, 3.f, 2.f, 1.f });
+static_assert(ffm::abs(ffm::norm(ffm::vec4f{ 0.f, 0.f, 2.f, 0.f })[2] - 1.f) < 1e-5f);
+
+constexpr ffm::mat4x4f camera = ffm::matrices::translate(ffm::vec3f{ 1.f, 2.f, 3.f }) * ffm::matrices::scale(ffm::vec3f{ 2.f, 2.f, 2.f });
+static_assert(camera[0][0] == 2.f && camera[0][3] == 1.f && camera[2][3] == 3.f && camera[3][3] == 1.f);
+static_assert(camera * ffm::vec4f{ 1.f, 1.f, 1.f, 1.f } == ffm::vec4f{ 3.f, 4.f, 5.f, 1.f });
+static_assert(ffm::transpose(camera)[3][0] == 1.f);
+static_assert(ffm::IdMat<ffm::mat3x3f>() * ffm::vec3f{ 1.f, 2.f, 3.f } == ffm::vec3f{ 1.f, 2.f, 3.f });
+
+constexpr ffm::mat4x4f projection = ffm::matrices::ortho(-2.f, 2.f, -1.f, 1.f, 1.f, 11.f);
+static_assert(projection[0][0] == 0.5f && projection[1][1] == 1.f && projection[2][2] == 0.2f && projection[2][3] == -1.2f);
+constexpr ffm::mat4x4f perspective = ffm::matrices::persp(ffm::pi<float> / 2, 1.f, 1.f, 3.f);
+static_assert(ffm::abs(perspective[1][1] - 1.f) < 1e-5f && perspective[3][2] == 1.f);
+constexpr ffm::mat4x4f view = ffm::matrices::gaze(ffm::vec3f{ 0.f, 0.f, 5.f }, ffm::vec3f{}, ffm::vec3f{ 0.f, 1.f, 0.f });
+static_assert(ffm::abs(view[2][2] - 1.f) < 1e-4f && ffm::abs(view[2][3] + 5.f) < 1e-4f);
+constexpr ffm::mat4x4f turn = ffm::matrices::rotate(ffm::pi<float> / 2, ffm::vec3f{ 0.f, 0.f, 1.f });
+static_assert(ffm::abs(turn[0][1] + 1.f) < 1e-4f && ffm::abs(turn[1][0] - 1.f) < 1e-4f);
+
+// Inverses fold at compile time through the generic templates.
+static_assert(ffm::determinant(camera) == 8.f && ffm::determinant(ffm::matrices::scale(ffm::vec2f{ 2.f, 3.f })) == 6.f);
+static_assert(ffm::inverse(camera) * ffm::vec4f{ 3.f, 4.f, 5.f, 1.f } == ffm::vec4f{ 1.f, 1.f, 1.f, 1.f });
+static_assert(ffm::affine_inverse(camera) * ffm::vec4f{ 3.f, 4.f, 5.f, 1.f } == ffm::vec4f{ 1.f, 1.f, 1.f, 1.f });
+static_assert(ffm::abs((ffm::affine_inverse(view) * ffm::vec4f{ 0.f, 0.f, 0.f, 1.f })[2] - 5.f) < 1e-4f);
+
+// Conversions through pipe views, widening, narrowing and concatenation.
+constexpr ffm::vec3f point{ 1.f, 2.f, 3.f };
+static_assert(ffm::vec4f(*point | 1.f) == ffm::vec4f{ 1.f, 2.f, 3.f, 1.f });
+static_assert(ffm::vec4f(0.f | *point.xy() | 5.f) == ffm::vec4f{ 0.f, 1.f, 2.f, 5.f });
+static_assert(ffm::vec2f(*ffm::vec4f{ 4.f, 3.f, 2.f, 1.f }) == ffm::vec2f{ 4.f, 3.f });
+static_assert(ffm::pipe4f(*point | *ffm::vec1f{ 7.f }).vdata[3] == 7.f);
+static_assert([] { ffm::vec3f v = point; v = 0.f | *v; return v; }() == ffm::vec3f{ 0.f, 1.f, 2.f });
+
+// Static concatenation, the dimension is part of the type.
+template <class A, class B>
+concept Concatenable = requires(A a, B b) { a | b; };
+static_assert(std::is_same_v<decltype(point | 1.f), ffm::vec4f>);
+static_assert((point | 1.f) == ffm::vec4f{ 1.f, 2.f, 3.f, 1.f });
+static_assert((0.f | point.xy() | 5.f) == ffm::vec4f{ 0.f, 1.f, 2.f, 5.f });
+static_assert((point.xy() | point.yzx().xy()) == ffm::vec4f{ 1.f, 2.f, 2.f, 3.f });
+static_assert(Concatenable<ffm::vec3f, float> && !Concatenable<ffm::vec4f, float> && !Concatenable<ffm::vec3f, ffm::vec2f>);
+
+// lazy() chains, assignments into themselves included, give the eager result.
+// Quarters scaled by 1.5 stay exact, so they compare with ==.
+template <class Vt>
+static bool lazy_matches() {
+    using storage = ffm::Expr_storage<Vt>;
+    Vt a, b, c;
+    float* const pa = const_cast<float*>(storage::data(a));
+    float* const pb = const_cast<float*>(storage::data(b));
+    float* const pc = const_cast<float*>(storage::data(c));
+    for (std::size_t i = 0; i < storage::size; ++i) {
+        pa[i] = static_cast<float>(i % 7) * 0.25f - 1.f;
+        pb[i] = static_cast<float>(i % 5) * 0.5f;
+        pc[i] = 2.f - static_cast<float>(i % 3) * 0.75f;
+    }
+    const float k = 1.5f;
+    const Vt built = ffm::lazy(a) + ffm::lazy(b) * k - ffm::lazy(c);
+    Vt set, add = a, sub = a, self = a;
+    set = -ffm::lazy(c) + ffm::lazy(a) / k;
+    add += ffm::lazy(b) * k - ffm::lazy(c);
+    sub -= k * ffm::lazy(b);
+    self = ffm::lazy(self) * k + b;
+    const Vt eager[] = { a + b * k - c, c * -1.f + a / k, a + (b * k - c), a - b * k, a * k + b };
+    const Vt* lazy[] = { &built, &set, &add, &sub, &self };
+    for (std::size_t n = 0; n < 5; ++n)
+        for (std::size_t i = 0; i < storage::size; ++i)
+            if (storage::data(*lazy[n])[i] != storage::data(eager[n])[i]) return false;
+    return true;
+}
+
+// soa_vector batch geometry against the basic_vector functions per element. 37 elements
+// leave a tail after every lane width, y one longer shows nothing past it is written.
+template <class Vt>
+static bool soa_matches() {
+    constexpr std::size_t n = 37, dim = Vt::dimension;
+    ffm::soa_vector<Vt> a(n), b(n), s(n + 1), k(n + 1);
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < dim; ++j) {
+            a[i][j] = static_cast<float>((i * 7 + j * 3) % 11) - 4.5f;
+            b[i][j] = static_cast<float>((i * 5 + j) % 9) * 0.25f + 0.5f;
+        }
+    Vt seven, one;
+    for (std::size_t j = 0; j < dim; ++j) { seven[j] = 7.f; one[j] = 1.f; }
+    s[n] = k[n] = seven;
+    std::array<float, n + 1> d{}, l{};
+    d[n] = l[n] = 7.f;
+    ffm::dot(a, b, d);
+    ffm::length(a, l);
+    ffm::add(a, b, s);
+    ffm::scale(a, -1.5f, k);
+    ffm::soa_vector<Vt> u = a;
+    ffm::norm(u, u);
+    const auto near = [](float x, float y) { return ffm::abs(x - y) <= 1e-5f * std::max(1.f, ffm::abs(y)); };
+    for (std::size_t i = 0; i < n; ++i) {
+        const Vt va = a[i], vb = b[i], vu = u[i], nu = ffm::norm(va);
+        if (!near(d[i], ffm::dot(va, vb)) || !near(l[i], ffm::length(va)) || Vt(s[i]) != va + vb || Vt(k[i]) != va * -1.5f) return false;
+        for (std::size_t j = 0; j < dim; ++j)
+            if (!near(vu[j], nu[j])) return false;
+    }
+    if (d[n] != 7.f || l[n] != 7.f || Vt(s[n]) != seven || Vt(k[n]) != seven) return false;
+    if constexpr (dim == 3) {
+        ffm::soa_vector<Vt> c(n), ca = a;
+        ffm::cross(a, b, c);
+        ffm::cross(ca, b, ca);
+        for (std::size_t i = 0; i < n; ++i)
+            if (Vt(c[i]) != ffm::cross(Vt(a[i]), Vt(b[i])) || Vt(ca[i]) != Vt(c[i])) return false;
+    }
+
+    // Writes through the element proxies land in the streams.
+    const Vt a5 = a[5], a6 = a[6];
+    a[3][dim - 1] = 42.f;
+    a[4] = b[5];
+    a[5] += one;
+    a[6] *= 2.f;
+    if (a.stream(dim - 1)[3] != 42.f || Vt(a[4]) != Vt(b[5]) || Vt(a[5]) != a5 + one || Vt(a[6]) != a6 * 2.f) return false;
+    return true;
+}
+
+// Packets load and store arrays of vectors unchanged, spans shorter than the
+// packet included, and lane i of dot/cross/norm/lerp is the function on vector i.
+template <class Packet>
+static bool packet_matches() {
+    using vec = ffm::basic_vector<float, Packet::dimension, ffm::pipe4f>;
+    constexpr std::size_t width = Packet::width, dim = Packet::dimension;
+    std::array<vec, width> a, b, back, part;
+    for (std::size_t i = 0; i < width; ++i)
+        for (std::size_t k = 0; k < dim; ++k) {
+            a[i][k] = static_cast<float>(i * dim + k) * 0.5f - 3.f;
+            b[i][k] = static_cast<float>((i + 2 * k) % 5) + 0.25f;
+        }
+    const Packet pa = Packet::load(a.data()), pb = Packet::load(std::span<const vec>(b));
+    pa.store(back.data());
+    const Packet pp = Packet::load(std::span<const vec>(a.data(), width - 1));
+    part.fill(b[0]);
+    pp.store(std::span<vec>(part.data(), width - 2));
+    for (std::size_t i = 0; i < width; ++i) {
+        if (back[i] != a[i] || pa.get(i) != a[i] || pb.get(i) != b[i]) return false;
+        if (pp.get(i) != (i < width - 1 ? a[i] : vec{}) || part[i] != (i < width - 2 ? a[i] : b[0])) return false;
+    }
+
+    alignas(64) float d[width], l[width];
+    Packet::lane_type::store(d, ffm::dot(pa, pb));
+    Packet::lane_type::store(l, ffm::length(pa));
+    const Packet pn = ffm::norm(pa), pl = ffm::lerp(pa, pb, 0.25f);
+    for (std::size_t i = 0; i < width; ++i) {
+        const vec n = ffm::norm(a[i]), m = pn.get(i), lv = pl.get(i), lr = a[i] + (b[i] - a[i]) * 0.25f;
+        if (ffm::abs(d[i] - ffm::dot(a[i], b[i])) > 1e-4f || ffm::abs(l[i] - ffm::length(a[i])) > 1e-4f) return false;
+        for (std::size_t k = 0; k < dim; ++k)
+            if (ffm::abs(m[k] - n[k]) > 1e-5f || ffm::abs(lv[k] - lr[k]) > 1e-5f) return false;
+        if constexpr (dim == 3) {
+            const vec c = ffm::cross(pa, pb).get(i);
+            if (c != ffm::cross(a[i], b[i])) return false;
+        }
+    }
+    return true;
+}
+
+// SIMDVector4<int> products wrap like unsigned ones, operator/ and SIMDDivisor4
+// round toward zero like int division.
+static bool simd_int_arith() {
+    using vec = ffm::SIMDVector4<int>;
+    const int wrap[4] = { 100000, -3, 46341, INT_MIN };
+    for (int k : { 3, -7, 100000, INT_MAX }) {
+        vec p{ wrap[0], wrap[1], wrap[2], wrap[3] };
+        const vec q = p * k;
+        p *= k;
+        for (std::size_t j = 0; j < 4; ++j) {
+            const int c = static_cast<int>(static_cast<unsigned>(wrap[j]) * static_cast<unsigned>(k));
+            if (p[j] != c || q[j] != c) return false;
+        }
+    }
+
+    std::mt19937 rng(15);
+    std::vector<int> divisors = { 1, -1, 2, -2, 3, -3, 7, -7, 641, -1000, 65536, INT_MAX, INT_MIN, INT_MIN + 1, 0x40000000 };
+    for (int i = 0; i < 200; ++i)
+        if (const int d = static_cast<int>(rng()) >> (rng() % 31); d != 0) divisors.push_back(d);
+    for (const int d : divisors) {
+        const ffm::SIMDDivisor4 dv(d);
+        for (int i = 0; i < 256; ++i) {
+            int n[4] = { static_cast<int>(rng()), -static_cast<int>(rng() % 20000), i == 0 ? INT_MIN : -static_cast<int>(rng() >> 1), i == 0 ? INT_MAX : static_cast<int>(rng() % 100) };
+            // INT_MIN / -1 overflows for int too.
+            if (d == -1) for (int& e : n) if (e == INT_MIN) e = INT_MIN + 1;
+            const vec a{ n[0], n[1], n[2], n[3] };
+            vec qd = a;
+            qd /= dv;
+            const vec qs = vec(a) / d, qm = a / dv;
+            for (std::size_t j = 0; j < 4; ++j)
+                if (qs[j] != n[j] / d || qm[j] != n[j] / d || qd[j] != n[j] / d || dv.divide(n[j]) != n[j] / d) return false;
+        }
+    }
+    return true;
+}
 
+// Lane-wise primary functions on SIMDVector4<float>. floor and round are exact
+// (signs of zero included) around 0.5 and past 2^23, rsqrt is good to 2^-21.
+static bool simd_float_primary() {
+    using vec = ffm::SIMDVector4<float>;
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    const std::array<float, 24> xs = { -2.5f, -1.5f, -0.5f, -0.49999997f, 0.49999997f, 0.5f, 1.5f, 2.5f, -0.3f, -0.f, 0.f, 3.7f,
+                                       8388607.5f, -8388607.5f, 8388609.f, -8388609.f, 1e9f, -1e9f, 0x1p30f, -7.f, inf, -inf, 123.456f, -0.7f };
+    for (std::size_t i = 0; i < xs.size(); i += 4) {
+        const vec x{ xs[i], xs[i + 1], xs[i + 2], xs[i + 3] };
+        const vec f = ffm::floor(x), r = ffm::round(x), a = ffm::abs(x);
+        for (std::size_t j = 0; j < 4; ++j)
+            if (std::bit_cast<int>(f[j]) != std::bit_cast<int>(std::floor(xs[i + j])) || std::bit_cast<int>(r[j]) != std::bit_cast<int>(std::round(xs[i + j])) ||
+                std::bit_cast<int>(a[j]) != std::bit_cast<int>(std::fabs(xs[i + j]))) return false;
+    }
+    const vec n = ffm::round(vec{ std::numeric_limits<float>::quiet_NaN(), 0.f, 0.f, 0.f });
+    if (n[0] == n[0]) return false;
+
+    for (float t = -20.f; t < 20.f; t += 0.01f) {
+        const vec x{ t, t + 0.0025f, t + 0.005f, t + 0.0075f };
+        vec s, c;
+        ffm::sincos(x, s, c);
+        vec u = ffm::abs(x);
+        u += vec{ 1e-3f, 1e-3f, 1e-3f, 1e-3f };
+        const vec sn = ffm::sin(x), cs = ffm::cos(x), e = ffm::exp(x), l = ffm::log(u);
+        for (std::size_t j = 0; j < 4; ++j) {
+            const double v = x[j];
+            if (std::fabs(sn[j] - std::sin(v)) > 5e-5 || std::fabs(cs[j] - std::cos(v)) > 5e-5) return false;
+            if (std::fabs(s[j] - std::sin(v)) > 5e-5 || std::fabs(c[j] - std::cos(v)) > 5e-5) return false;
+            if (std::fabs(e[j] / std::exp(v) - 1) > 5e-5 || std::fabs(l[j] - std::log(static_cast<double>(u[j]))) > 1e-6) return false;
+        }
+    }
+    for (float t = 1e-30f; t < 1e30f; t *= 1.001f) {
+        const vec x{ t, t * 1.0002f, t * 1.0005f, t * 1.0007f };
+        const vec q = ffm::rsqrt(x), sq = ffm::sqrt(x);
+        for (std::size_t j = 0; j < 4; ++j)
+            if (std::fabs(q[j] * std::sqrt(static_cast<double>(x[j])) - 1) > 0x1p-21 || sq[j] != std::sqrt(x[j])) return false;
+    }
+    return true;
+}
+
+// Lane masks, select, min/max/clamp and the reductions against scalar code lane by lane.
+// NaN lanes only check the masks and select, min and max of NaN follow minps/maxps.
+template <typename Ty>
+static bool simd_lanes(const std::array<Ty, 4>& x, const std::array<Ty, 4>& y) {
+    using vec = ffm::SIMDVector4<Ty>;
+    const vec a{ x[0], x[1], x[2], x[3] }, b{ y[0], y[1], y[2], y[3] }, lo{ -3, -3, -3, -3 }, hi{ 4, 4, 4, 4 };
+    int lt = 0, le = 0, gt = 0, ge = 0, ne = 0, eq = 0;
+    for (std::size_t j = 0; j < 4; ++j) {
+        lt |= (x[j] <  y[j]) << j; le |= (x[j] <= y[j]) << j; gt |= (x[j] >  y[j]) << j;
+        ge |= (x[j] >= y[j]) << j; ne |= (x[j] != y[j]) << j; eq |= (x[j] == y[j]) << j;
+    }
+    if ((a < b).bits() != lt || (a <= b).bits() != le || (a > b).bits() != gt || (a >= b).bits() != ge ||
+        (a != b).bits() != ne || ffm::equal(a, b).bits() != eq) return false;
+    if ((~(a < b)).bits() != (lt ^ 0xf) || ((a < b) | (a > b)).bits() != (lt | gt) || ((a <= b) & (a >= b)).bits() != (le & ge) ||
+        ((a <= b) ^ (a < b)).bits() != (le ^ lt)) return false;
+    if (ffm::any(a < b) != (lt != 0) || ffm::all(a < b) != (lt == 0xf) || ffm::none(a < b) != (lt == 0)) return false;
+    const vec s = ffm::select(a < b, a, b);
+    for (std::size_t j = 0; j < 4; ++j)
+        if (std::bit_cast<int>(s[j]) != std::bit_cast<int>(x[j] < y[j] ? x[j] : y[j])) return false;
+
+    if (std::any_of(x.begin(), x.end(), [](Ty v) { return v != v; }) || std::any_of(y.begin(), y.end(), [](Ty v) { return v != v; })) return true;
+    const vec mn = ffm::min(a, b), mx = ffm::max(a, b), c = ffm::clamp(a, lo, hi);
+    for (std::size_t j = 0; j < 4; ++j)
+        if (mn[j] != std::min(x[j], y[j]) || mx[j] != std::max(x[j], y[j]) || c[j] != std::clamp(x[j], Ty(-3), Ty(4))) return false;
+    Ty sum = x[0];
+    if constexpr (std::is_same_v<Ty, int>) sum = static_cast<int>(static_cast<unsigned>(x[0]) + x[1] + x[2] + x[3]);
+    else                                   sum = x[0] + x[1] + x[2] + x[3];
+    return ffm::hsum(a) == sum && ffm::hmin(a) == *std::min_element(x.begin(), x.end()) && ffm::hmax(a) == *std::max_element(x.begin(), x.end());
+}
+
+// Distance in units in the last place, -0 and 0 are the same point.
+static std::int64_t ulps(float a, float b) {
+    const auto line = [](float f) -> std::int64_t {
+        const std::int32_t i = std::bit_cast<std::int32_t>(f);
+        return i < 0 ? -std::int64_t{ i & 0x7fff'ffff } : i;
+    };
+    const std::int64_t d = line(a) - line(b);
+    return d < 0 ? -d : d;
+}
+
+// Every batch function against its scalar one at every isa. n leaves a tail
+// on all lane counts, and nothing may be written past min(x.size(), y.size()).
+static bool batch_matches() {
+    constexpr std::size_t n = 203;
+    constexpr float sentinel = 12345.f;
+    std::mt19937 rng(7);
+    const auto fill = [&](float lo, float hi) {
+        std::uniform_real_distribution<float> d(lo, hi);
+        std::vector<float> v(n + 5);
+        for (float& f : v) f = d(rng);
+        return v;
+    };
+    bool ok = true;
+    // y one longer than x, then x longer than y, y[n] stays untouched both times.
+    // The batch cos is more accurate than the standard scalar one, those two
+    // only agree within an absolute bound.
+    const auto check = [&](auto batch, std::int64_t tol, float abs_tol) {
+        for (const bool longer_y : { true, false }) {
+            std::vector<float> y(n + 1, sentinel), ref(n);
+            batch(longer_y ? n : n + 5, std::span<float>(y.data(), longer_y ? n + 1 : n), ref);
+            for (std::size_t i = 0; i < n; ++i)
+                if (ulps(y[i], ref[i]) > tol && !(std::fabs(y[i] - ref[i]) <= abs_tol)) ok = false;
+            if (y[n] != sentinel) ok = false;
+        }
+    };
+    const std::vector<float> trig = fill(-10.f, 10.f), pos = fill(1e-3f, 1e4f), any = fill(-1e4f, 1e4f);
+    const std::vector<float> e = fill(-20.f, 20.f), unit = fill(-1.f, 1.f), base = fill(1e-2f, 10.f);
+    const std::vector<float> pw = fill(-4.f, 4.f), wide = fill(-50.f, 50.f), u = fill(-5.f, 5.f), v = fill(-5.f, 5.f);
+#define BATCH_UNARY(name, in, abs_tol)                                                  \
+    check([&](std::size_t xs, std::span<float> y, std::vector<float>& ref) {            \
+        ffm::name(std::span<const float>(in.data(), xs), y);                            \
+        for (std::size_t i = 0; i < n; ++i) ref[i] = ffm::name(in[i]);                  \
+    }, 4, abs_tol)
+    for (const ffm::isa level : { ffm::isa::scalar, ffm::isa::sse2, ffm::isa::avx2, ffm::isa::avx512 }) {
+        if (ffm::select_isa(level) != ffm::active_isa()) return false;
+        BATCH_UNARY(sqrt, pos, 0.f);   BATCH_UNARY(rsqrt, pos, 0.f);  BATCH_UNARY(cbrt, any, 0.f);
+        BATCH_UNARY(log, pos, 0.f);    BATCH_UNARY(exp, e, 0.f);      BATCH_UNARY(sin, trig, 0.f);
+        BATCH_UNARY(cos, trig, 5e-5f); BATCH_UNARY(tan, trig, 0.f);   BATCH_UNARY(asin, unit, 0.f);
+        BATCH_UNARY(acos, unit, 0.f);  BATCH_UNARY(atan, wide, 0.f);
+        check([&](std::size_t xs, std::span<float> y, std::vector<float>& ref) {
+            ffm::pow(std::span<const float>(base.data(), xs), 2.5f, y);
+            for (std::size_t i = 0; i < n; ++i) ref[i] = ffm::pow(base[i], 2.5f);
+        }, 4, 0.f);
+        check([&](std::size_t xs, std::span<float> y, std::vector<float>& ref) {
+            ffm::pow(std::span<const float>(base.data(), xs), std::span<const float>(pw.data(), xs), y);
+            for (std::size_t i = 0; i < n; ++i) ref[i] = ffm::pow(base[i], pw[i]);
+        }, 4, 0.f);
+        check([&](std::size_t xs, std::span<float> y, std::vector<float>& ref) {
+            ffm::atan2(std::span<const float>(u.data(), xs), std::span<const float>(v.data(), xs), y);
+            for (std::size_t i = 0; i < n; ++i) ref[i] = ffm::atan2(u[i], v[i]);
+        }, 4, 0.f);
+        // sincos, one output checked per pass, the other one only for its sentinel.
+        for (const bool cosines : { false, true })
+            check([&](std::size_t xs, std::span<float> y, std::vector<float>& ref) {
+                std::vector<float> other(n + 1, sentinel);
+                const std::span<float> o(other.data(), y.size());
+                ffm::sincos(std::span<const float>(trig.data(), xs), cosines ? o : y, cosines ? y : o);
+                for (std::size_t i = 0; i < n; ++i) ref[i] = cosines ? ffm::cos(trig[i]) : ffm::sin(trig[i]);
+                if (other[n] != sentinel) ok = false;
+            }, 4, 5e-5f);
+    }
+#undef BATCH_UNARY
+    ffm::select_isa(ffm::detected_isa());
+    return ok;
+}
+
+// Bulk float16_t and bfloat16_t conversions at every isa against the scalar
+// types: every 16 bit pattern widened, random float bit patterns narrowed.
+// NaN only has to stay NaN with its sign, F16C keeps the payload.
+static bool half_matches() {
+    constexpr std::size_t n = 1 << 16;
+    const auto same = [](std::uint32_t a, std::uint32_t b) {
+        const bool nan_a = std::isnan(std::bit_cast<float>(a)), nan_b = std::isnan(std::bit_cast<float>(b));
+        return nan_a || nan_b ? nan_a && nan_b && (a >> 31) == (b >> 31) : a == b;
+    };
+    std::vector<ffm::float16_t> h(n), hn(n);
+    std::vector<ffm::bfloat16_t> b(n), bn(n);
+    for (std::size_t i = 0; i < n; ++i) h[i].bits = b[i].bits = static_cast<std::uint16_t>(i);
+    // Odd count so every lane count leaves a tail.
+    std::mt19937 rng(9);
+    std::vector<float> f(1001);
+    for (float& v : f) v = std::bit_cast<float>(static_cast<std::uint32_t>(rng()));
+    std::vector<ffm::float16_t> fh(f.size());
+    std::vector<ffm::bfloat16_t> fb(f.size());
+    std::vector<float> wide(n);
+    for (const ffm::isa level : { ffm::isa::scalar, ffm::isa::sse2, ffm::isa::avx2, ffm::isa::avx512 }) {
+        if (ffm::select_isa(level) != ffm::active_isa()) return false;
+        ffm::widen(h, wide);
+        for (std::size_t i = 0; i < n; ++i)
+            if (!same(std::bit_cast<std::uint32_t>(wide[i]), std::bit_cast<std::uint32_t>(static_cast<float>(h[i])))) return false;
+        // Every half value survives the round trip, NaN aside.
+        ffm::narrow(wide, hn);
+        for (std::size_t i = 0; i < n; ++i)
+            if (!std::isnan(wide[i]) && hn[i].bits != h[i].bits) return false;
+        ffm::widen(b, wide);
+        for (std::size_t i = 0; i < n; ++i)
+            if (!same(std::bit_cast<std::uint32_t>(wide[i]), std::bit_cast<std::uint32_t>(static_cast<float>(b[i])))) return false;
+        ffm::narrow(wide, bn);
+        for (std::size_t i = 0; i < n; ++i)
+            if (!std::isnan(wide[i]) && bn[i].bits != b[i].bits) return false;
+
+        ffm::narrow(f, fh);
+        ffm::narrow(f, fb);
+        for (std::size_t i = 0; i < f.size(); ++i) {
+            const ffm::float16_t sh(f[i]);
+            const ffm::bfloat16_t sb(f[i]);
+            if (!same(std::bit_cast<std::uint32_t>(static_cast<float>(fh[i])), std::bit_cast<std::uint32_t>(static_cast<float>(sh)))) return false;
+            if (!same(std::bit_cast<std::uint32_t>(static_cast<float>(fb[i])), std::bit_cast<std::uint32_t>(static_cast<float>(sb)))) return false;
+            if (!std::isnan(f[i]) && (fh[i].bits != sh.bits || fb[i].bits != sb.bits)) return false;
+        }
+    }
+    ffm::select_isa(ffm::detected_isa());
+    return true;
+}
+
+// A throwing chunk reaches the Parallel_for caller and leaves the pool usable.
+static bool pool_rethrows() {
+    constexpr std::size_t n = 1 << 16;
+    std::atomic<std::size_t> done{ 0 };
+    try {
+        ffm::Parallel_for(n, 64, [&](std::size_t begin, std::size_t end) {
+            if (begin <= n / 2 && n / 2 < end) throw "chunk failed";
+            done += end - begin;
+        });
+        return false;
+    } catch (const char*) {
+    }
+    if (done >= n) return false;
+    done = 0;
+    ffm::Parallel_for(n, 64, [&](std::size_t begin, std::size_t end) { done += end - begin; });
+    return done == n;
+}
+
+int main(int argc, char* argv[]) {
     // namespace ffg = force::geom; // Geometry library
     // namespace ffp = force::phys; // Physics library
     // namespace ffv = force::vibr; // Audio and wave handling library
@@ -15,4 +456,68 @@ int main(int argc, char* argv[]) {
     ffm::vec4f a = { 1.f, 2.f, 3.f, 4.f};
 
     std::cout << a << std::endl;
+
+    // Products this large go through the blocked GEMM, with edge tiles on every side.
+    using mat_a = ffm::basic_matrix<float, 50, 37, ffm::pipe4f>;
+    using mat_b = ffm::basic_matrix<float, 37, 45, ffm::pipe4f>;
+    static mat_a ma; static mat_b mb;
+    for (std::size_t i = 0; i < 50 * 37; ++i) ma.adata[i] = static_cast<float>(i % 11) - 5.f;
+    for (std::size_t i = 0; i < 37 * 45; ++i) mb.adata[i] = static_cast<float>(i % 7) * 0.5f;
+    const auto mc = ma * mb;
+    for (std::size_t i = 0; i < 50; ++i)
+        for (std::size_t j = 0; j < 45; ++j) {
+            float s = 0;
+            for (std::size_t k = 0; k < 37; ++k) s += ma[i][k] * mb[k][j];
+            if (mc[i][j] != s) return 1;
+        }
+
+    // simd inverses and their batch versions against the generic templates.
+    const ffm::mat4x4f trs = ffm::matrices::translate(ffm::vec3f{ 1.f, -2.f, 3.f }) * ffm::matrices::rotate(0.7f, ffm::vec3f{ 0.f, 0.6f, 0.8f }) *
+                             ffm::matrices::scale(ffm::vec3f{ 2.f, 0.5f, 1.5f });
+    const ffm::mat3x3f trs2 = ffm::matrices::translate(ffm::vec2f{ 4.f, 1.f }) * ffm::matrices::rotate(1.1f, ffm::vec2f{}) * ffm::matrices::scale(ffm::vec2f{ 3.f, 2.f });
+    std::array<ffm::mat4x4f, 5> m4{ trs, trs, trs, trs, trs }, i4{};
+    std::array<ffm::mat3x3f, 5> m3{ trs2, trs2, trs2, trs2, trs2 }, i3{};
+    std::array<float, 5> d4{}, d3{};
+    ffm::inverse(m4, i4);
+    ffm::affine_inverse(m3, i3);
+    ffm::determinant(m4, d4);
+    ffm::determinant(m3, d3);
+    const auto near = [](auto a, auto b) { return ffm::abs(a - b) < 1e-4f; };
+    for (std::size_t i = 0; i < 4; ++i)
+        for (std::size_t j = 0; j < 4; ++j) {
+            const float g = ffm::inverse<float, 4, ffm::pipe4f>(trs)[i][j];
+            if (!near(ffm::inverse(trs)[i][j], g) || !near(ffm::affine_inverse(trs)[i][j], g) || !near(i4[4][i][j], g)) return 1;
+            if (i < 3 && j < 3 && (!near(ffm::inverse(trs2)[i][j], ffm::inverse<float, 3, ffm::pipe4f>(trs2)[i][j]) ||
+                                   !near(i3[4][i][j], ffm::inverse<float, 3, ffm::pipe4f>(trs2)[i][j]))) return 1;
+        }
+    if (!near(ffm::determinant(trs), 1.5f) || !near(d4[4], 1.5f) || !near(ffm::determinant(trs2), 6.f) || !near(d3[4], 6.f)) return 1;
+
+    // The same product sized at run time, read back as the fixed size type.
+    const ffm::dynamic_matf da(ma), db(mb);
+    const ffm::dynamic_matf dc = da * db;
+    const auto& fc = dc.fixed<std::remove_const_t<decltype(mc)>>();
+    ffm::basic_vector<float, 37, ffm::pipe4f> x;
+    for (std::size_t i = 0; i < 37; ++i) x[i] = static_cast<float>(i % 3);
+    const ffm::dynamic_vecf y = da * ffm::dynamic_vecf(x);
+    for (std::size_t i = 0; i < 50; ++i) {
+        float s = 0;
+        for (std::size_t k = 0; k < 37; ++k) s += ma[i][k] * x[k];
+        if (y[i] != s) return 1;
+        for (std::size_t j = 0; j < 45; ++j)
+            if (fc[i][j] != mc[i][j]) return 1;
+    }
+
+    if (!simd_int_arith() || !simd_float_primary()) return 1;
+    if (!lazy_matches<ffm::vec3f>() || !lazy_matches<ffm::vec4f>() || !lazy_matches<ffm::basic_vector<float, 37, ffm::pipe4f>>() ||
+        !lazy_matches<ffm::mat3x3f>() || !lazy_matches<ffm::mat4x4f>() || !lazy_matches<mat_a>()) return 1;
+    if (!packet_matches<ffm::vec3x4>() || !packet_matches<ffm::vec4x4>() || !packet_matches<ffm::vec2x4>()) return 1;
+    if (!soa_matches<ffm::vec2f>() || !soa_matches<ffm::vec3f>() || !soa_matches<ffm::vec4f>()) return 1;
+    if (!pool_rethrows()) return 1;
+    if (!batch_matches() || !half_matches()) return 1;
+
+    constexpr float nan = std::numeric_limits<float>::quiet_NaN(), inf = std::numeric_limits<float>::infinity();
+    if (!simd_lanes<float>({ 1.f, -5.f, 3.f, 7.f }, { 2.f, -5.f, -1.f, 9.f }) || !simd_lanes<float>({ -0.f, inf, -1e30f, 2.5f }, { 0.f, inf, -inf, -2.5f }) ||
+        !simd_lanes<float>({ nan, 1.f, nan, -2.f }, { 1.f, nan, nan, -2.f })) return 1;
+    if (!simd_lanes<int>({ 1, -5, 3, 7 }, { 2, -5, -1, 9 }) || !simd_lanes<int>({ INT_MIN, -1, 0, INT_MAX }, { INT_MAX, -1, 1, INT_MIN }) ||
+        !simd_lanes<int>({ -4, 5, -3, 4 }, { -4, 6, INT_MIN, -1 })) return 1;
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+// Accuracy and throughput harness for primary.hpp.
+// Sweeps float bit patterns over a range, compares every result against the
+// double precision std:: function and reports max/mean ulp error, a histogram
+// of the error and ns per element. The sweep is split across all cores.
+// Two argument functions (atan2) can't be swept, they get random pairs of
+// float bit patterns instead, the same ones for any thread count.
+//
+// usage: force_math_ulp [name ...] [-r lo hi] [-s stride] [-n pairs] [-t threads]
+//   name      functions to test, default all (sin, sin<fast>, ..., atan2).
+//   -r lo hi  only inputs in [lo, hi], default every float in each function's domain.
+//   -s stride test every stride-th bit pattern, default 1 (exhaustive).
+//   -n pairs  random pairs for two argument functions, default 1e8.
+//   -t n      worker threads, default std::thread::hardware_concurrency().
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmath/primary.hpp>
+
+namespace ffm = force::math;
+using ffm::precision;
+
+struct entry {
+    const char* name;
+    float  (*fn)(float);
+    double (*ref)(double);
+    // Inputs the function claims to support, everything else is skipped.
+    float  lo, hi;
+};
+
+constexpr float flt_max  = std::numeric_limits<float>::max();
+constexpr float flt_norm = std::numeric_limits<float>::min();
+
+const entry entries[] = {
+    { "sqrt",           [](float x) { return ffm::sqrt(x); },                     [](double x) { return std::sqrt(x); },       flt_norm, flt_max },
+    { "sqrt<fast>",     [](float x) { return ffm::sqrt<precision::fast>(x); },    [](double x) { return std::sqrt(x); },       flt_norm, flt_max },
+    { "sqrt<precise>",  [](float x) { return ffm::sqrt<precision::precise>(x); }, [](double x) { return std::sqrt(x); },       flt_norm, flt_max },
+    { "rsqrt",          [](float x) { return ffm::rsqrt(x); },                    [](double x) { return 1. / std::sqrt(x); },  flt_norm, flt_max },
+    { "rsqrt<fast>",    [](float x) { return ffm::rsqrt<precision::fast>(x); },   [](double x) { return 1. / std::sqrt(x); },  flt_norm, flt_max },
+    { "rsqrt<precise>", [](float x) { return ffm::rsqrt<precision::precise>(x); },[](double x) { return 1. / std::sqrt(x); },  flt_norm, flt_max },
+    { "cbrt",           [](float x) { return ffm::cbrt(x); },                     [](double x) { return std::cbrt(x); },       -flt_max, flt_max },
+    { "cbrt<fast>",     [](float x) { return ffm::cbrt<precision::fast>(x); },    [](double x) { return std::cbrt(x); },       -flt_max, flt_max },
+    { "cbrt<precise>",  [](float x) { return ffm::cbrt<precision::precise>(x); }, [](double x) { return std::cbrt(x); },       -flt_max, flt_max },
+    { "log",            [](float x) { return ffm::log(x); },                      [](double x) { return std::log(x); },        flt_norm, flt_max },
+    { "log<fast>",      [](float x) { return ffm::log<precision::fast>(x); },     [](double x) { return std::log(x); },        flt_norm, flt_max },
+    { "log<precise>",   [](float x) { return ffm::log<precision::precise>(x); },  [](double x) { return std::log(x); },        flt_norm, flt_max },
+    { "exp",            [](float x) { return ffm::exp(x); },                      [](double x) { return std::exp(x); },        -87.f, 88.f },
+    { "exp<fast>",      [](float x) { return ffm::exp<precision::fast>(x); },     [](double x) { return std::exp(x); },        -87.f, 88.f },
+    { "exp<precise>",   [](float x) { return ffm::exp<precision::precise>(x); },  [](double x) { return std::exp(x); },        -87.f, 88.f },
+    { "sin",            [](float x) { return ffm::sin(x); },                      [](double x) { return std::sin(x); },        -1e5f, 1e5f },
+    { "sin<fast>",      [](float x) { return ffm::sin<precision::fast>(x); },     [](double x) { return std::sin(x); },        -1e5f, 1e5f },
+    { "sin<precise>",   [](float x) { return ffm::sin<precision::precise>(x); },  [](double x) { return std::sin(x); },        -1e5f, 1e5f },
+    { "cos",            [](float x) { return ffm::cos(x); },                      [](double x) { return std::cos(x); },        -1e5f, 1e5f },
+    { "cos<fast>",      [](float x) { return ffm::cos<precision::fast>(x); },     [](double x) { return std::cos(x); },        -1e5f, 1e5f },
+    { "cos<precise>",   [](float x) { return ffm::cos<precision::precise>(x); },  [](double x) { return std::cos(x); },        -1e5f, 1e5f },
+    { "tan",            [](float x) { return ffm::tan(x); },                      [](double x) { return std::tan(x); },        -1e5f, 1e5f },
+    { "asin",           [](float x) { return ffm::asin(x); },                     [](double x) { return std::asin(x); },       -1.f, 1.f },
+    { "acos",           [](float x) { return ffm::acos(x); },                     [](double x) { return std::acos(x); },       -1.f, 1.f },
+    { "atan",           [](float x) { return ffm::atan(x); },                     [](double x) { return std::atan(x); },       -flt_max, flt_max },
+    { "acot",           [](float x) { return ffm::acot(x); },                     [](double x) { return std::atan(1. / x); },  -flt_max, flt_max },
+    { "asec",           [](float x) { return ffm::asec(x); },                     [](double x) { return std::acos(1. / x); },  -flt_max, flt_max },
+    { "acsc",           [](float x) { return ffm::acsc(x); },                     [](double x) { return std::asin(1. / x); },  -flt_max, flt_max },
+};
+
+struct entry2 {
+    const char* name;
+    float  (*fn)(float, float);
+    double (*ref)(double, double);
+    float  lo, hi;
+};
+
+const entry2 entries2[] = {
+    { "atan2",          [](float y, float x) { return ffm::atan2(y, x); },        [](double y, double x) { return std::atan2(y, x); }, -flt_max, flt_max },
+};
+
+// Floats ordered as integers, so a range of keys is a range of floats.
+uint32_t key_of(float x) {
+    uint32_t u = std::bit_cast<uint32_t>(x);
+    return (u & 0x8000'0000u) ? ~u : (u | 0x8000'0000u);
+}
+float float_of(uint32_t k) {
+    return std::bit_cast<float>((k & 0x8000'0000u) ? (k & 0x7fff'ffffu) : ~k);
+}
+// Error of got in units of the float ulp at the exact result.
+double ulp_error(float got, double ref) {
+    double a = std::fabs(ref);
+    int    e = a < flt_norm ? -126 : std::ilogb(static_cast<float>(a));
+    if (a >= flt_max) e = 127;
+    return std::fabs(static_cast<double>(got) - ref) / std::ldexp(1., e - 23);
+}
+
+// Bucket 0 is exact, bucket b holds errors in (2^(b-2), 2^(b-1)], the last one is the rest.
+constexpr int buckets = 28;
+int bucket_of(double u) {
+    if (u == 0.) return 0;
+    int b = static_cast<int>(std::ceil(std::log2(u))) + 2;
+    return b < 1 ? 1 : (b >= buckets ? buckets - 1 : b);
+}
+
+struct stats {
+    uint64_t count   = 0;
+    uint64_t invalid = 0;            // NaN or inf where the exact result is finite.
+    double   sum     = 0.;
+    double   max     = 0.;
+    float    argmax  = 0.f;
+    float    argmax2 = 0.f;          // Second argument of the worst pair.
+    double   ns      = 0.;           // Time spent in the function itself, summed over threads.
+    uint64_t timed   = 0;
+    uint64_t hist[buckets] = {};
+
+    void merge(const stats& o) {
+        count += o.count; invalid += o.invalid; sum += o.sum; ns += o.ns; timed += o.timed;
+        if (o.max > max) { max = o.max; argmax = o.argmax; argmax2 = o.argmax2; }
+        for (int i = 0; i < buckets; ++i) hist[i] += o.hist[i];
+    }
+};
+
+stats sweep(const entry& en, float lo, float hi, uint32_t stride, unsigned threads) {
+    lo = std::max(lo, en.lo);
+    hi = std::min(hi, en.hi);
+    stats total;
+    if (!(lo <= hi)) return total;
+
+    const uint64_t first = key_of(lo), last = key_of(hi);
+    const uint64_t n     = (last - first) / stride + 1;
+    constexpr uint64_t chunk = 1 << 16;
+    std::atomic<uint64_t> next{ 0 };
+    std::mutex lock;
+
+    auto work = [&] {
+        stats st;
+        std::vector<float> xs(chunk), ys(chunk);
+        for (uint64_t c; (c = next.fetch_add(chunk)) < n;) {
+            uint64_t m = std::min(chunk, n - c);
+            for (uint64_t i = 0; i < m; ++i) xs[i] = float_of(static_cast<uint32_t>(first + (c + i) * stride));
+
+            auto t0 = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < m; ++i) ys[i] = en.fn(xs[i]);
+            auto t1 = std::chrono::steady_clock::now();
+            st.ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            st.timed += m;
+
+            for (uint64_t i = 0; i < m; ++i) {
+                double r = en.ref(xs[i]);
+                if (!std::isfinite(r)) continue;
+                ++st.count;
+                if (!std::isfinite(ys[i])) { ++st.invalid; continue; }
+                double u = ulp_error(ys[i], r);
+                st.sum += u;
+                ++st.hist[bucket_of(u)];
+                if (u > st.max) { st.max = u; st.argmax = xs[i]; }
+            }
+        }
+        std::lock_guard<std::mutex> g(lock);
+        total.merge(st);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; ++i) pool.emplace_back(work);
+    for (auto& t : pool) t.join();
+    return total;
+}
+
+// Random pairs for entry2, chunk c always draws from a generator seeded with c.
+stats sweep(const entry2& en, float lo, float hi, uint64_t pairs, unsigned threads) {
+    lo = std::max(lo, en.lo);
+    hi = std::min(hi, en.hi);
+    stats total;
+    if (!(lo <= hi)) return total;
+
+    const uint32_t first = key_of(lo), last = key_of(hi);
+    constexpr uint64_t chunk = 1 << 16;
+    std::atomic<uint64_t> next{ 0 };
+    std::mutex lock;
+
+    auto work = [&] {
+        stats st;
+        std::vector<float> ys(chunk), xs(chunk), rs(chunk);
+        for (uint64_t c; (c = next.fetch_add(chunk)) < pairs;) {
+            uint64_t m = std::min(chunk, pairs - c);
+            std::mt19937 rng(static_cast<uint32_t>(c / chunk));
+            std::uniform_int_distribution<uint32_t> key(first, last);
+            for (uint64_t i = 0; i < m; ++i) { ys[i] = float_of(key(rng)); xs[i] = float_of(key(rng)); }
+
+            auto t0 = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < m; ++i) rs[i] = en.fn(ys[i], xs[i]);
+            auto t1 = std::chrono::steady_clock::now();
+            st.ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+            st.timed += m;
+
+            for (uint64_t i = 0; i < m; ++i) {
+                double r = en.ref(ys[i], xs[i]);
+                if (!std::isfinite(r)) continue;
+                ++st.count;
+                if (!std::isfinite(rs[i])) { ++st.invalid; continue; }
+                double u = ulp_error(rs[i], r);
+                st.sum += u;
+                ++st.hist[bucket_of(u)];
+                if (u > st.max) { st.max = u; st.argmax = ys[i]; st.argmax2 = xs[i]; }
+            }
+        }
+        std::lock_guard<std::mutex> g(lock);
+        total.merge(st);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned i = 0; i < threads; ++i) pool.emplace_back(work);
+    for (auto& t : pool) t.join();
+    return total;
+}
+
+void report(const char* name, const stats& st) {
+    double valid = static_cast<double>(st.count - st.invalid);
+    std::printf("%-15s %12llu %12.4g %14.8g %10.4g %9llu %8.3f\n", name,
+        static_cast<unsigned long long>(st.count), st.max, st.argmax,
+        valid > 0 ? st.sum / valid : 0., static_cast<unsigned long long>(st.invalid),
+        st.timed ? st.ns / static_cast<double>(st.timed) : 0.);
+    std::printf("    histogram  0:%llu", static_cast<unsigned long long>(st.hist[0]));
+    for (int b = 1; b < buckets; ++b) {
+        if (!st.hist[b]) continue;
+        if (b == buckets - 1) std::printf("  >2^%d:%llu", b - 3, static_cast<unsigned long long>(st.hist[b]));
+        else                  std::printf("  <=2^%d:%llu", b - 2, static_cast<unsigned long long>(st.hist[b]));
+    }
+    std::printf("\n");
+}
+
+int main(int argc, char* argv[]) {
+    float    lo = -flt_max, hi = flt_max;
+    uint32_t stride  = 1;
+    uint64_t pairs   = 100'000'000;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> names;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-r") && i + 2 < argc) { lo = std::strtof(argv[i + 1], nullptr); hi = std::strtof(argv[i + 2], nullptr); i += 2; }
+        else if (!std::strcmp(argv[i], "-s") && i + 1 < argc) stride  = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "-n") && i + 1 < argc) pairs   = std::max(1ull, std::strtoull(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "-t") && i + 1 < argc) threads = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        else names.emplace_back(argv[i]);
+    }
+
+    std::printf("range [%g, %g], stride %u, %u threads\n", lo, hi, stride, threads);
+    std::printf("%-15s %12s %12s %14s %10s %9s %8s\n", "function", "tested", "max ulp", "at x", "mean ulp", "invalid", "ns/elem");
+    for (const entry& en : entries) {
+        if (!names.empty() && std::find(names.begin(), names.end(), en.name) == names.end()) continue;
+        report(en.name, sweep(en, lo, hi, stride, threads));
+    }
+    for (const entry2& en : entries2) {
+        if (!names.empty() && std::find(names.begin(), names.end(), en.name) == names.end()) continue;
+        const stats st = sweep(en, lo, hi, pairs, threads);
+        report(en.name, st);
+        std::printf("    %llu random pairs, worst at (%.8g, %.8g)\n", static_cast<unsigned long long>(pairs), st.argmax, st.argmax2);
+    }
+}
@@ -0,0 +1,106 @@
+#include <climits>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include <fmath/primary.hpp>
+#include <fmath/vector.hpp>
+
+#if !(FMA_ARCH & FMA_ARCH_AVX2_BIT)
+#error "Build with FMA_FORCE_INTRINSICS and AVX2 or AVX-512 enabled."
+#endif
+
+namespace ffm = force::math;
+
+// SIMDVector8 and SIMDVector16 only exist when the whole build targets AVX2 or
+// AVX-512, CMake builds this file and force_lib's sources once per level.
+// Every lane is checked against the same operation on plain floats and ints.
+
+template <class Vec>
+static bool wide_float(std::mt19937& rng) {
+    constexpr std::size_t N = Vec::dimension;
+    std::uniform_real_distribution<float> dist(-8.f, 8.f);
+    for (int r = 0; r < 1000; ++r) {
+        Vec a, b;
+        for (std::size_t j = 0; j < N; ++j) { a[j] = dist(rng); b[j] = dist(rng); }
+        const float k = dist(rng) + 16.f;
+        Vec ai = a, as = a, am = a, ad = a;
+        ai += b; as -= b; am *= k; ad /= k;
+        const Vec sum = a + b, dif = a - b, mul = a * k, quo = a / k, neg = -a, pos = +a;
+        float d = 0.f, ref = 0.f;
+        for (std::size_t j = 0; j < N; ++j) {
+            if (sum[j] != a[j] + b[j] || ai[j] != sum[j] || dif[j] != a[j] - b[j] || as[j] != dif[j]) return false;
+            if (mul[j] != a[j] * k || am[j] != mul[j] || quo[j] != a[j] / k || ad[j] != quo[j]) return false;
+            if (neg[j] != -a[j] || pos[j] != a[j]) return false;
+            d += a[j] * b[j]; ref += a[j] * a[j];
+        }
+        // The lanes are summed in a different order.
+        if (std::fabs(ffm::dot(a, b) - d) > 1e-4f * N * 64.f || std::fabs(ffm::length(a) - std::sqrt(ref)) > 1e-3f * std::sqrt(ref)) return false;
+        const Vec n = ffm::norm(a);
+        for (std::size_t j = 0; j < N; ++j)
+            if (std::fabs(n[j] - a[j] / std::sqrt(ref)) > 1e-3f) return false;
+        if (!(a == a) || a == neg || !(sum == ai)) return false;
+    }
+    return true;
+}
+
+template <class Vec>
+static bool wide_int(std::mt19937& rng) {
+    constexpr std::size_t N = Vec::dimension;
+    for (const int k : { 1, -1, 3, -7, 1000, INT_MAX, INT_MIN }) {
+        for (int r = 0; r < 200; ++r) {
+            Vec a, b;
+            for (std::size_t j = 0; j < N; ++j) { a[j] = static_cast<int>(rng()); b[j] = static_cast<int>(rng()); }
+            // INT_MIN / -1 overflows for int too.
+            if (k == -1) for (std::size_t j = 0; j < N; ++j) if (a[j] == INT_MIN) a[j] = 0;
+            Vec ai = a, as = a, am = a, ad = a;
+            ai += b; as -= b; am *= k; ad /= k;
+            const Vec sum = a + b, dif = a - b, mul = a * k, quo = a / k, neg = -a;
+            for (std::size_t j = 0; j < N; ++j) {
+                const auto ua = static_cast<unsigned>(a[j]), ub = static_cast<unsigned>(b[j]);
+                if (sum[j] != static_cast<int>(ua + ub) || ai[j] != sum[j] || dif[j] != static_cast<int>(ua - ub) || as[j] != dif[j]) return false;
+                if (mul[j] != static_cast<int>(ua * static_cast<unsigned>(k)) || am[j] != mul[j]) return false;
+                if (quo[j] != a[j] / k || ad[j] != quo[j] || neg[j] != static_cast<int>(0u - ua)) return false;
+            }
+            if (!(a == a) || (b[0] != a[0] && a == b)) return false;
+        }
+    }
+    return true;
+}
+
+// The 8 and 16 lane packets load and store through their own shuffles.
+template <class Packet>
+static bool wide_packet() {
+    using vec = ffm::basic_vector<float, Packet::dimension, ffm::pipe4f>;
+    constexpr std::size_t width = Packet::width, dim = Packet::dimension;
+    vec a[width], back[width];
+    for (std::size_t i = 0; i < width; ++i)
+        for (std::size_t k = 0; k < dim; ++k) a[i][k] = static_cast<float>(i * dim + k) - 5.f;
+    const Packet p = Packet::load(a);
+    p.store(back);
+    alignas(64) float d[width];
+    Packet::lane_type::store(d, ffm::dot(p, p));
+    for (std::size_t i = 0; i < width; ++i)
+        if (back[i] != a[i] || p.get(i) != a[i] || d[i] != ffm::dot(a[i], a[i])) return false;
+    return true;
+}
+
+int main() {
+    // Built for a level this cpu lacks, nothing to run.
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+    if (ffm::active_isa() != ffm::isa::avx512) return 0;
+#else
+    if (ffm::active_isa() < ffm::isa::avx2) return 0;
+#endif
+    std::mt19937 rng(10);
+#if FMA_ARCH & FMA_ARCH_AVX2_BIT
+    if (!wide_float<ffm::SIMDVector8<float>>(rng) || !wide_int<ffm::SIMDVector8<int>>(rng)) return 1;
+    if (!wide_packet<ffm::vec2x8>() || !wide_packet<ffm::vec3x8>() || !wide_packet<ffm::vec4x8>()) return 1;
+    std::cout << "SIMDVector8 ok" << std::endl;
+#endif
+#if FMA_ARCH & FMA_ARCH_AVX512_BIT
+    if (!wide_float<ffm::SIMDVector16<float>>(rng) || !wide_int<ffm::SIMDVector16<int>>(rng)) return 1;
+    if (!wide_packet<ffm::vec2x16>() || !wide_packet<ffm::vec3x16>() || !wide_packet<ffm::vec4x16>()) return 1;
+    std::cout << "SIMDVector16 ok" << std::endl;
+#endif
+}